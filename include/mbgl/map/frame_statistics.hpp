@@ -0,0 +1,55 @@
+#ifndef MBGL_MAP_FRAME_STATISTICS
+#define MBGL_MAP_FRAME_STATISTICS
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Time spent in a named part of a frame. GPU times are measured with timer queries; they are
+// only available when the driver supports them and reports no disjoint timer.
+struct FrameSection {
+    std::string name;
+    Duration cpuTime = Duration::zero();
+    Duration gpuTime = Duration::zero();
+    bool hasGPUTime = false;
+
+    // Fragments that passed the stencil and depth tests, counted with occlusion queries for
+    // render passes when the driver supports them.
+    uint64_t fragments = 0;
+    bool hasFragments = false;
+};
+
+struct FrameStatistics {
+    // Sequence number of the frame these statistics describe. Because GPU timings arrive
+    // asynchronously, this usually lags the most recently rendered frame by a few frames.
+    uint64_t frame = 0;
+
+    FrameSection total;
+
+    // Render passes (upload, clip, placement, opaque, translucent, debug) in the order they ran.
+    std::vector<FrameSection> passes;
+
+    // Style layers in the order they were first rendered. Layers that are drawn in both the
+    // opaque and the translucent pass report the sum of both.
+    std::vector<FrameSection> layers;
+
+    // Number of GL state changes that were skipped because the state was already set.
+    uint64_t redundantGLCalls = 0;
+
+    // Size of the framebuffer in pixels.
+    uint64_t pixels = 0;
+
+    // Average number of fragments drawn per pixel by all passes, or 0 if fragments weren't
+    // counted. Opaque layers are drawn front to back, so this is mostly due to translucent ones.
+    double overdraw() const;
+
+    std::string toJSON() const;
+};
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/map/update.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/frame_statistics.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/vec.hpp>
@@ -88,6 +89,12 @@ public:
     void setDefaultTransitionDelay(const Duration& = Duration::zero());
     Duration getDefaultTransitionDelay() const;
 
+    // Changes a property of a single layer. The value is JSON, as in the style, e.g. "\"#f00\""
+    // or "{ \"stops\": [[10, 1], [16, 4]] }". Paint properties can be set for a class.
+    void setPaintProperty(const std::string& layer, const std::string& name, const std::string& value,
+                          const std::string& klass = "");
+    void setLayoutProperty(const std::string& layer, const std::string& name, const std::string& value);
+
     void setStyleURL(const std::string& url);
     void setStyleJSON(const std::string& json, const std::string& base = "");
     std::string getStyleURL() const;
@@ -169,6 +176,12 @@ public:
     bool getCollisionDebug() const;
     bool isFullyLoaded() const;
 
+    // Profiling. While enabled, every frame records CPU and GPU time per render pass and per
+    // style layer. Use FrameStatistics::toJSON() to dump them.
+    void setFrameProfiling(bool value);
+    bool getFrameProfiling() const;
+    FrameStatistics getFrameStatistics() const;
+
 private:
     View& view;
     const std::unique_ptr<Transform> transform;
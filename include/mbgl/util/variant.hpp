@@ -550,16 +550,45 @@ public:
         helper_type::move(old.type_index, &old.data, &data);
     }
 
+private:
+    VARIANT_INLINE void copy_assign(variant<Types...> const& rhs)
+    {
+        if (this == &rhs) return;
+        helper_type::destroy(type_index, &data);
+        type_index = detail::invalid_value;
+        helper_type::copy(rhs.type_index, &rhs.data, &data);
+        type_index = rhs.type_index;
+    }
+
+    VARIANT_INLINE void move_assign(variant<Types...> && rhs)
+    {
+        if (this == &rhs) return;
+        helper_type::destroy(type_index, &data);
+        type_index = detail::invalid_value;
+        helper_type::move(rhs.type_index, &rhs.data, &data);
+        type_index = rhs.type_index;
+    }
+
+public:
+    // Assignment and swap destroy the current value and copy or move the new one in place.
+    // Swapping the raw storage instead would break values that point into themselves, like
+    // short strings.
     friend void swap(variant<Types...> & first, variant<Types...> & second)
     {
-        using std::swap; //enable ADL
-        swap(first.type_index, second.type_index);
-        swap(first.data, second.data);
+        variant<Types...> temp(std::move(first));
+        first.move_assign(std::move(second));
+        second.move_assign(std::move(temp));
+    }
+
+    VARIANT_INLINE variant<Types...>& operator=(variant<Types...> && other)
+    {
+        move_assign(std::move(other));
+        return *this;
     }
 
-    VARIANT_INLINE variant<Types...>& operator=(variant<Types...> other)
+    VARIANT_INLINE variant<Types...>& operator=(variant<Types...> const& other)
     {
-        swap(*this, other);
+        copy_assign(other);
         return *this;
     }
 
@@ -569,7 +598,7 @@ public:
     VARIANT_INLINE variant<Types...>& operator=(T && rhs) noexcept
     {
         variant<Types...> temp(std::forward<T>(rhs));
-        swap(*this, temp);
+        move_assign(std::move(temp));
         return *this;
     }
 
@@ -578,7 +607,7 @@ public:
     VARIANT_INLINE variant<Types...>& operator=(T const& rhs)
     {
         variant<Types...> temp(rhs);
-        swap(*this, temp);
+        move_assign(std::move(temp));
         return *this;
     }
 
@@ -96,6 +96,14 @@ void GLFWView::onKey(GLFWwindow *window, int key, int /*scancode*/, int action,
         case GLFW_KEY_C:
             view->map->toggleCollisionDebug();
             break;
+        case GLFW_KEY_F:
+            // The first press turns on frame profiling; later ones dump the latest statistics.
+            if (view->map->getFrameProfiling()) {
+                mbgl::Log::Info(mbgl::Event::Render, "%s", view->map->getFrameStatistics().toJSON().c_str());
+            } else {
+                view->map->setFrameProfiling(true);
+            }
+            break;
         case GLFW_KEY_X:
             if (!mods)
                 view->map->resetPosition();
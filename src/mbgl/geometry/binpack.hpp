@@ -3,100 +3,362 @@
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/rect.hpp>
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
-#include <list>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <vector>
 
 namespace mbgl {
 
+// Skyline bottom-left packer with a waste map (see http://clb.demon.fi/files/RectangleBinPack.pdf,
+// section 4). New rects are put on top of the skyline wherever their top ends up lowest. Space
+// that is covered up underneath them, as well as released rects, is kept as free rects, which
+// are tried first. Released rects are merged with adjacent free rects, and lower the skyline
+// again when they are at the top of it. Merging only along full edges can leave L-shaped free
+// space behind, so the bin starts over once the last rect has been released.
 template <typename T>
 class BinPack : private util::noncopyable {
 public:
-    BinPack(T width, T height)
-        : free(1, Rect<uint16_t>{ 0, 0, width, height }) {}
+    BinPack(T width_, T height_)
+        : width(width_), height(height_), skyline(1, Segment { 0, 0, width_ }) {
+        while (leaves <= height) {
+            leaves *= 2;
+        }
+        maxWidth.resize(2 * leaves, 0);
+    }
 public:
-    Rect<T> allocate(T width, T height) {
-        // Find the smallest free rect angle
-        auto smallest = free.end();
-        for (auto it = free.begin(); it != free.end(); ++it) {
-            const Rect<T>& ref = *it;
-            const Rect<T>& rect = *smallest;
-            if (width <= ref.w && height <= ref.h) {
-                if (smallest == free.end() || (ref.y <= rect.y && ref.x <= rect.x)) {
-                    smallest = it;
-                } else {
-                    // Our current "smallest" rect is already closer to 0/0.
-                }
-            } else {
-                // The rect in the free list is not big enough.
-            }
+    Rect<T> allocate(T w, T h) {
+        if (w == 0 || h == 0 || w > width || h > height) {
+            return Rect<T>{ 0, 0, 0, 0 };
+        }
+
+        Rect<T> rect = allocateFree(w, h);
+        if (rect.w == 0) {
+            rect = allocateSkyline(w, h);
+        }
+        if (rect.w != 0) {
+            ++allocated;
+        }
+        return rect;
+    }
+
+    void release(Rect<T> rect) {
+        assert(allocated > 0);
+        if (--allocated == 0) {
+            reset();
+            return;
+        }
+
+        rect = coalesce(Rect<T>(rect.x, rect.y, rect.w, rect.h));
+        if (!lowerSkyline(rect)) {
+            addFree(rect);
+        }
+    }
+
+private:
+    struct Segment {
+        T x, y, w;
+    };
+
+    // Free rects don't overlap, so their position identifies them. The size order is used to find
+    // the lowest free rect that is tall and wide enough, the row and column orders to find
+    // neighbors to merge with.
+    struct BySize {
+        bool operator()(const Rect<T>& a, const Rect<T>& b) const {
+            return std::tie(a.h, a.w, a.y, a.x) < std::tie(b.h, b.w, b.y, b.x);
+        }
+    };
+    struct ByRow {
+        bool operator()(const Rect<T>& a, const Rect<T>& b) const {
+            return std::tie(a.y, a.x) < std::tie(b.y, b.x);
+        }
+    };
+    struct ByColumn {
+        bool operator()(const Rect<T>& a, const Rect<T>& b) const {
+            return std::tie(a.x, a.y) < std::tie(b.x, b.y);
         }
+    };
+
+    Rect<T> allocateFree(T w, T h) {
+        const int32_t fitHeight = findHeight(1, 0, leaves, w, h);
+        if (fitHeight < 0) {
+            return Rect<T>{ 0, 0, 0, 0 };
+        }
+
+        // The narrowest one of that height that is wide enough.
+        auto it = bySize.lower_bound(Rect<T>(0, 0, w, fitHeight));
+        assert(it != bySize.end() && it->h == fitHeight && it->w >= w);
 
-        if (smallest == free.end()) {
-            // There's no space left for this char.
-            return Rect<uint16_t>{ 0, 0, 0, 0 };
+        const Rect<T> rect = *it;
+        removeFree(rect);
+
+        // Shorter Axis Split Rule: the leftover strip along the shorter axis stays small.
+        // +--+---+
+        // |__|___|  <-- right
+        // +------+  <-- bottom
+        if (rect.w - w < rect.h - h) {
+            if (rect.w > w) addFree(Rect<T>(rect.x + w, rect.y, rect.w - w, h));
+            if (rect.h > h) addFree(Rect<T>(rect.x, rect.y + h, rect.w, rect.h - h));
         } else {
-            Rect<T> rect = *smallest;
-            free.erase(smallest);
-
-            // Shorter/Longer Axis Split Rule (SAS)
-            // http://clb.demon.fi/files/RectangleBinPack.pdf p. 15
-            // Ignore the dimension of R and just split long the shorter dimension
-            // See Also: http://www.cs.princeton.edu/~chazelle/pubs/blbinpacking.pdf
-            if (rect.w < rect.h) {
-                // split horizontally
-                // +--+---+
-                // |__|___|  <-- b1
-                // +------+  <-- b2
-                if (rect.w > width) free.emplace_back(rect.x + width, rect.y, rect.w - width, height);
-                if (rect.h > height) free.emplace_back(rect.x, rect.y + height, rect.w, rect.h - height);
+            if (rect.w > w) addFree(Rect<T>(rect.x + w, rect.y, rect.w - w, rect.h));
+            if (rect.h > h) addFree(Rect<T>(rect.x, rect.y + h, w, rect.h - h));
+        }
+
+        return Rect<T>(rect.x, rect.y, w, h);
+    }
+
+    Rect<T> allocateSkyline(T w, T h) {
+        size_t best = skyline.size();
+        int32_t bestY = 0;
+
+        for (size_t i = 0; i < skyline.size(); ++i) {
+            const int32_t y = fit(i, w, h);
+            if (y >= 0 && (best == skyline.size() || y < bestY)) {
+                best = i;
+                bestY = y;
+            }
+        }
+
+        if (best == skyline.size()) {
+            // There's no space left for this rect.
+            return Rect<T>{ 0, 0, 0, 0 };
+        }
+
+        const T x = skyline[best].x;
+        const T y = bestY;
+        const int32_t right = x + w;
+
+        // The space between the skyline and the new rect can still be used for smaller rects.
+        for (size_t i = best; i < skyline.size() && skyline[i].x < right; ++i) {
+            const Segment& segment = skyline[i];
+            if (segment.y < y) {
+                const int32_t end = std::min<int32_t>(segment.x + segment.w, right);
+                addFree(coalesce(Rect<T>(segment.x, segment.y, end - segment.x, y - segment.y)));
+            }
+        }
+
+        // Replace the segments underneath the new rect with its top edge.
+        size_t i = best;
+        while (i < skyline.size() && skyline[i].x < right) {
+            Segment& segment = skyline[i];
+            const int32_t end = segment.x + segment.w;
+            if (end <= right) {
+                skyline.erase(skyline.begin() + i);
             } else {
-                // split vertically
-                // +--+---+
-                // |__|   | <-- b1
-                // +--|---+ <-- b2
-                if (rect.w > width) free.emplace_back(rect.x + width, rect.y, rect.w - width, rect.h);
-                if (rect.h > height) free.emplace_back(rect.x, rect.y + height, width, rect.h - height);
+                segment.w = end - right;
+                segment.x = right;
+                break;
             }
+        }
+        skyline.insert(skyline.begin() + best, Segment { x, T(y + h), w });
+        mergeSkyline();
+
+        return Rect<T>(x, y, w, h);
+    }
+
+    // Returns the y at which a rect whose left edge is at the given skyline segment would sit, or
+    // -1 if it doesn't fit there.
+    int32_t fit(size_t index, T w, T h) const {
+        if (skyline[index].x + w > width) {
+            return -1;
+        }
+
+        int32_t y = 0;
+        int32_t remaining = w;
+        for (size_t i = index; remaining > 0; ++i) {
+            y = std::max<int32_t>(y, skyline[i].y);
+            remaining -= skyline[i].w;
+        }
+
+        return y + h <= height ? y : -1;
+    }
 
-            return Rect<uint16_t>{ rect.x, rect.y, width, height };
+    void mergeSkyline() {
+        for (size_t i = 1; i < skyline.size();) {
+            if (skyline[i - 1].y == skyline[i].y) {
+                skyline[i - 1].w += skyline[i].w;
+                skyline.erase(skyline.begin() + i);
+            } else {
+                ++i;
+            }
         }
     }
 
+    // Index of the skyline segment that contains x.
+    size_t findSegment(T x) const {
+        auto it = std::upper_bound(skyline.begin(), skyline.end(), x, [](T value, const Segment& segment) {
+            return value < segment.x;
+        });
+        return std::distance(skyline.begin(), it) - 1;
+    }
 
-    void release(Rect<T> rect) {
-        // Simple algorithm to recursively merge the newly released cell with its
-        // neighbor. This doesn't merge more than two cells at a time, and fails
-        // for complicated merges.
-        for (auto it = free.begin(); it != free.end(); ++it) {
-            Rect<T> ref = *it;
-            if (ref.y == rect.y && ref.h == rect.h && ref.x + ref.w == rect.x) {
-                ref.w += rect.w;
+    // Lowers the skyline to the bottom of a free rect that spans its top along its entire width.
+    bool lowerSkyline(const Rect<T>& rect) {
+        const int32_t top = rect.y + rect.h;
+        const int32_t right = rect.x + rect.w;
+
+        const size_t first = findSegment(rect.x);
+        size_t last = first;
+        for (; last < skyline.size() && skyline[last].x < right; ++last) {
+            if (skyline[last].y != top) {
+                return false;
             }
-            else if (ref.x == rect.x && ref.w == rect.w && ref.y + ref.h == rect.y) {
-                ref.h += rect.h;
+        }
+
+        // Split off the parts of the outer segments that aren't covered by the rect.
+        const Segment before = skyline[first];
+        const Segment after = skyline[last - 1];
+        skyline.erase(skyline.begin() + first, skyline.begin() + last);
+
+        std::vector<Segment> lowered;
+        if (before.x < rect.x) {
+            lowered.push_back({ before.x, before.y, T(rect.x - before.x) });
+        }
+        lowered.push_back({ rect.x, rect.y, rect.w });
+        if (after.x + after.w > right) {
+            lowered.push_back({ T(right), after.y, T(after.x + after.w - right) });
+        }
+        skyline.insert(skyline.begin() + first, lowered.begin(), lowered.end());
+        mergeSkyline();
+
+        // Free rects underneath may now be at the top of the skyline, too.
+        std::vector<Rect<T>> below;
+        for (auto it = byColumn.begin(); it != byColumn.end() && it->x < right; ++it) {
+            if (it->y + it->h == rect.y && it->x + it->w > rect.x) {
+                below.push_back(*it);
             }
-            else if (rect.y == ref.y && rect.h == ref.h && rect.x + rect.w == ref.x) {
-                ref.x = rect.x;
-                ref.w += rect.w;
+        }
+        for (const Rect<T>& free : below) {
+            if (lowerSkyline(free)) {
+                removeFree(free);
             }
-            else if (rect.x == ref.x && rect.w == ref.w && rect.y + rect.h == ref.y) {
-                ref.y = rect.y;
-                ref.h += rect.h;
-            } else {
+        }
+
+        return true;
+    }
+
+    // Removes the free rects that share a full edge with the given rect and returns the union.
+    Rect<T> coalesce(Rect<T> rect) {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+
+            auto next = byRow.lower_bound(rect);
+            if (next != byRow.begin()) {
+                const Rect<T> left = *std::prev(next);
+                if (left.y == rect.y && left.h == rect.h && left.x + left.w == rect.x) {
+                    removeFree(left);
+                    rect = Rect<T>(left.x, rect.y, left.w + rect.w, rect.h);
+                    merged = true;
+                    continue;
+                }
+            }
+
+            auto right = byRow.find(Rect<T>(rect.x + rect.w, rect.y, 0, 0));
+            if (right != byRow.end() && right->h == rect.h) {
+                const Rect<T> neighbor = *right;
+                removeFree(neighbor);
+                rect = Rect<T>(rect.x, rect.y, rect.w + neighbor.w, rect.h);
+                merged = true;
                 continue;
             }
 
-            free.erase(it);
-            release(ref);
-            return;
+            next = byColumn.lower_bound(rect);
+            if (next != byColumn.begin()) {
+                const Rect<T> above = *std::prev(next);
+                if (above.x == rect.x && above.w == rect.w && above.y + above.h == rect.y) {
+                    removeFree(above);
+                    rect = Rect<T>(rect.x, above.y, rect.w, above.h + rect.h);
+                    merged = true;
+                    continue;
+                }
+            }
 
+            auto below = byColumn.find(Rect<T>(rect.x, rect.y + rect.h, 0, 0));
+            if (below != byColumn.end() && below->w == rect.w) {
+                const Rect<T> neighbor = *below;
+                removeFree(neighbor);
+                rect = Rect<T>(rect.x, rect.y, rect.w, rect.h + neighbor.h);
+                merged = true;
+            }
         }
 
-        free.emplace_back(rect);
-    };
+        return rect;
+    }
 
-private:
-    std::list<Rect<T>> free;
+    // Returns the smallest height of at least h in the given node of the maxWidth tree that has a
+    // free rect of at least width w, or -1 if there is none.
+    int32_t findHeight(size_t node, size_t begin, size_t end, T w, T h) const {
+        if (end <= h || maxWidth[node] < w) {
+            return -1;
+        }
+        if (end - begin == 1) {
+            return int32_t(begin);
+        }
+
+        const size_t middle = (begin + end) / 2;
+        const int32_t result = findHeight(2 * node, begin, middle, w, h);
+        return result >= 0 ? result : findHeight(2 * node + 1, middle, end, w, h);
+    }
+
+    // Updates the maxWidth tree after a free rect of the given height was added or removed.
+    void updateMaxWidth(T h) {
+        // The size order puts the widest free rect of a height last.
+        const T max = std::numeric_limits<T>::max();
+        auto it = bySize.upper_bound(Rect<T>(max, max, max, h));
+        const T w = (it != bySize.begin() && std::prev(it)->h == h) ? std::prev(it)->w : 0;
+
+        size_t node = leaves + h;
+        maxWidth[node] = w;
+        for (node /= 2; node > 0; node /= 2) {
+            maxWidth[node] = std::max(maxWidth[2 * node], maxWidth[2 * node + 1]);
+        }
+    }
+
+    void addFree(const Rect<T>& rect) {
+        bySize.insert(rect);
+        byRow.insert(rect);
+        byColumn.insert(rect);
+        updateMaxWidth(rect.h);
+    }
+
+    void removeFree(const Rect<T>& rect) {
+        bySize.erase(rect);
+        byRow.erase(rect);
+        byColumn.erase(rect);
+        updateMaxWidth(rect.h);
+    }
+
+    void reset() {
+        skyline.assign(1, Segment { 0, 0, width });
+        bySize.clear();
+        byRow.clear();
+        byColumn.clear();
+        std::fill(maxWidth.begin(), maxWidth.end(), 0);
+    }
+
+    const T width;
+    const T height;
+
+    // Sorted by x; covers the whole width without gaps.
+    std::vector<Segment> skyline;
+
+    std::set<Rect<T>, BySize> bySize;
+    std::set<Rect<T>, ByRow> byRow;
+    std::set<Rect<T>, ByColumn> byColumn;
+
+    // A segment tree over the heights of the free rects that holds the widest free rect of each
+    // height. Together with the size order, it finds the shortest free rect that is tall and wide
+    // enough in O(log n).
+    size_t leaves = 1;
+    std::vector<T> maxWidth;
+
+    // Number of rects that have been allocated and not released yet.
+    size_t allocated = 0;
 };
 
 }
@@ -1,8 +1,10 @@
 #ifndef MBGL_GEOMETRY_BUFFER
 #define MBGL_GEOMETRY_BUFFER
 
+#include <mbgl/geometry/buffer_arena.hpp>
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
+#include <mbgl/renderer/gl_config.hpp>
 #include <mbgl/util/gl_object_store.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/thread_context.hpp>
@@ -24,7 +26,14 @@ public:
     ~Buffer() {
         cleanup();
         if (buffer != 0) {
-            util::ThreadContext::getGLObjectStore()->abandonBuffer(buffer);
+            if (suballocated) {
+                BufferArena* arena = util::ThreadContext::getBufferArena();
+                if (arena) {
+                    arena->release(bufferType, { buffer, offset }, pos);
+                }
+            } else {
+                util::ThreadContext::getGLObjectStore()->abandonBuffer(buffer);
+            }
             buffer = 0;
         }
     }
@@ -39,18 +48,29 @@ public:
         return pos == 0;
     }
 
-    // Transfers this buffer to the GPU and binds the buffer to the GL context.
+    // Transfers this buffer to the GPU and binds the buffer to the GL context. When a BufferArena
+    // is available, the data is placed into a range of a shared GL buffer; draw calls then need to
+    // add getOffset() to their byte offsets.
     void bind() {
         if (buffer) {
-            MBGL_CHECK_ERROR(glBindBuffer(bufferType, buffer));
+            gl::bindBuffer(bufferType, buffer);
         } else {
-            MBGL_CHECK_ERROR(glGenBuffers(1, &buffer));
-            MBGL_CHECK_ERROR(glBindBuffer(bufferType, buffer));
             if (array == nullptr) {
                 Log::Debug(Event::OpenGL, "Buffer doesn't contain elements");
                 pos = 0;
             }
-            MBGL_CHECK_ERROR(glBufferData(bufferType, pos, array, GL_STATIC_DRAW));
+            BufferArena* arena = util::ThreadContext::getBufferArena();
+            if (arena && pos > 0) {
+                const BufferArena::Range range = arena->allocate(bufferType, pos);
+                buffer = range.buffer;
+                offset = range.offset;
+                suballocated = true;
+                MBGL_CHECK_ERROR(glBufferSubData(bufferType, offset, pos, array));
+            } else {
+                MBGL_CHECK_ERROR(glGenBuffers(1, &buffer));
+                gl::bindBuffer(bufferType, buffer);
+                MBGL_CHECK_ERROR(glBufferData(bufferType, pos, array, GL_STATIC_DRAW));
+            }
             if (!retainAfterUpload) {
                 cleanup();
             }
@@ -68,6 +88,11 @@ public:
         return buffer;
     }
 
+    // Byte offset of this buffer's data within the GL buffer returned by getID().
+    inline size_t getOffset() const {
+        return offset;
+    }
+
     // Uploads the buffer to the GPU to be available when we need it.
     inline void upload() {
         if (!buffer) {
@@ -120,6 +145,10 @@ private:
 
     // GL buffer ID
     GLuint buffer = 0;
+
+    // Byte offset into the GL buffer, and whether that buffer is shared through a BufferArena.
+    size_t offset = 0;
+    bool suballocated = false;
 };
 
 }
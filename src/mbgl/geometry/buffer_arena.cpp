@@ -0,0 +1,141 @@
+#include <mbgl/geometry/buffer_arena.hpp>
+#include <mbgl/renderer/gl_config.hpp>
+#include <mbgl/util/gl_object_store.hpp>
+#include <mbgl/util/thread_context.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+const size_t BufferArena::pageSize;
+const size_t BufferArena::alignment;
+
+static inline size_t align(size_t size) {
+    return (size + BufferArena::alignment - 1) & ~(BufferArena::alignment - 1);
+}
+
+BufferArena::~BufferArena() {
+    clear();
+}
+
+BufferArena::Pages& BufferArena::getPages(GLenum target) {
+    return target == GL_ELEMENT_ARRAY_BUFFER ? elementPages : vertexPages;
+}
+
+BufferArena::Page& BufferArena::createPage(Pages& pages, GLenum target, size_t size) {
+    auto page = std::make_unique<Page>();
+    page->size = std::max(size, pageSize);
+    page->free.emplace(0, page->size);
+
+    MBGL_CHECK_ERROR(glGenBuffers(1, &page->buffer));
+    gl::bindBuffer(target, page->buffer);
+    MBGL_CHECK_ERROR(glBufferData(target, page->size, nullptr, GL_STATIC_DRAW));
+
+    reservedBytes += page->size;
+    pages.emplace_back(std::move(page));
+    return *pages.back();
+}
+
+void BufferArena::abandonPage(Page& page) {
+    util::ThreadContext::getGLObjectStore()->abandonBuffer(page.buffer);
+    reservedBytes -= page.size;
+    page.buffer = 0;
+}
+
+BufferArena::Range BufferArena::allocate(GLenum target, size_t size) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    size = align(size);
+
+    Pages& pages = getPages(target);
+
+    Page* page = nullptr;
+    std::map<size_t, size_t>::iterator it;
+
+    // First fit: pages are few and free lists short, so a linear scan is cheap.
+    for (auto& candidate : pages) {
+        it = std::find_if(candidate->free.begin(), candidate->free.end(),
+                          [size](const std::pair<const size_t, size_t>& range) { return range.second >= size; });
+        if (it != candidate->free.end()) {
+            page = candidate.get();
+            gl::bindBuffer(target, page->buffer);
+            break;
+        }
+    }
+
+    if (!page) {
+        page = &createPage(pages, target, size);
+        it = page->free.begin();
+    }
+
+    Range range;
+    range.buffer = page->buffer;
+    range.offset = it->first;
+
+    const size_t remaining = it->second - size;
+    page->free.erase(it);
+    if (remaining) {
+        page->free.emplace(range.offset + size, remaining);
+    }
+
+    allocatedBytes += size;
+    return range;
+}
+
+void BufferArena::release(GLenum target, const Range& range, size_t size) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    size = align(size);
+
+    Pages& pages = getPages(target);
+    auto pageIt = std::find_if(pages.begin(), pages.end(), [&](const std::unique_ptr<Page>& page) {
+        return page->buffer == range.buffer;
+    });
+    if (pageIt == pages.end()) {
+        return;
+    }
+
+    Page& page = **pageIt;
+    auto it = page.free.emplace(range.offset, size).first;
+
+    // Coalesce with the following free range.
+    auto next = std::next(it);
+    if (next != page.free.end() && it->first + it->second == next->first) {
+        it->second += next->second;
+        page.free.erase(next);
+    }
+
+    // Coalesce with the preceding free range.
+    if (it != page.free.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second == it->first) {
+            prev->second += it->second;
+            page.free.erase(it);
+            it = prev;
+        }
+    }
+
+    allocatedBytes -= size;
+
+    // Keep one page per target around so that a tile being replaced doesn't immediately
+    // cause the page to be recreated; everything beyond that is given back to the driver.
+    if (it->first == 0 && it->second == page.size && pages.size() > 1) {
+        abandonPage(page);
+        pages.erase(pageIt);
+    }
+}
+
+void BufferArena::clear() {
+    for (auto pages : { &vertexPages, &elementPages }) {
+        for (auto& page : *pages) {
+            abandonPage(*page);
+        }
+        pages->clear();
+    }
+    allocatedBytes = 0;
+}
+
+size_t BufferArena::getPageCount() const {
+    return vertexPages.size() + elementPages.size();
+}
+
+}
@@ -0,0 +1,74 @@
+#ifndef MBGL_GEOMETRY_BUFFER_ARENA
+#define MBGL_GEOMETRY_BUFFER_ARENA
+
+#include <mbgl/platform/gl.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace mbgl {
+
+// Suballocates vertex and element data from a small number of large, shared GL buffers instead
+// of creating one GL buffer per Buffer object. Freed ranges go back into a per-page free list and
+// are merged with their neighbors. Must only be used on the thread that owns the GL context.
+class BufferArena : private util::noncopyable {
+public:
+    struct Range {
+        GLuint buffer = 0;
+        size_t offset = 0;
+    };
+
+    // Size of a regular page. Allocations that don't fit into a page get a dedicated one.
+    static const size_t pageSize = 1024 * 1024;
+
+    // All ranges start at a multiple of this value.
+    static const size_t alignment = 16;
+
+    BufferArena() = default;
+    ~BufferArena();
+
+    // Reserves a range of at least `size` bytes in a buffer of type `target`. The returned buffer
+    // is bound to `target` when this function returns.
+    Range allocate(GLenum target, size_t size);
+
+    // Returns a range obtained from allocate() back to the free list. Ranges of buffers that are
+    // no longer owned by this arena (e.g. after clear()) are ignored.
+    void release(GLenum target, const Range&, size_t size);
+
+    // Abandons all pages. Buffers that still reference ranges in them must not be drawn anymore.
+    void clear();
+
+    size_t getPageCount() const;
+
+    // Number of bytes handed out to buffers vs. bytes reserved on the GPU.
+    size_t getAllocatedBytes() const { return allocatedBytes; }
+    size_t getReservedBytes() const { return reservedBytes; }
+
+private:
+    struct Page {
+        GLuint buffer = 0;
+        size_t size = 0;
+
+        // Free ranges, keyed by offset.
+        std::map<size_t, size_t> free;
+    };
+
+    typedef std::vector<std::unique_ptr<Page>> Pages;
+
+    Pages& getPages(GLenum target);
+    Page& createPage(Pages&, GLenum target, size_t size);
+    void abandonPage(Page&);
+
+    Pages vertexPages;
+    Pages elementPages;
+
+    size_t allocatedBytes = 0;
+    size_t reservedBytes = 0;
+};
+
+}
+
+#endif
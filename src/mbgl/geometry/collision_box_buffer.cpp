@@ -10,16 +10,17 @@ size_t CollisionBoxVertexBuffer::add(int16_t x, int16_t y, float ox, float oy, f
     const size_t idx = index();
     void *data = addElement();
 
-    int16_t *shorts = static_cast<int16_t *>(data);
-    shorts[0] /* pos */ = x;
-    shorts[1] /* pos */ = y;
-    shorts[2] /* offset */ = std::round(ox); // use 1/64 pixels for placement
-    shorts[3] /* offset */ = std::round(oy);
-
-    uint8_t *ubytes = static_cast<uint8_t *>(data);
-    // a_data1
-    ubytes[8] = maxzoom * 10;
-    ubytes[9] = placementZoom * 10;
+    int16_t *position = Layout::pos::get(data);
+    position[0] = x;
+    position[1] = y;
+
+    int16_t *extrude = Layout::extrude::get(data);
+    extrude[0] = std::round(ox);
+    extrude[1] = std::round(oy);
+
+    uint8_t *ubytes = Layout::data::get(data);
+    ubytes[0] = maxzoom * 10;
+    ubytes[1] = placementZoom * 10;
 
     return idx;
 }
@@ -2,16 +2,18 @@
 #define MBGL_GEOMETRY_COLLISIONBOX_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 #include <array>
 
 namespace mbgl {
 
 class CollisionBoxVertexBuffer : public Buffer <
-    12,
+    CollisionBoxVertexLayout::stride,
     GL_ARRAY_BUFFER,
     32768
 > {
 public:
+    typedef CollisionBoxVertexLayout Layout;
     typedef int16_t vertex_type;
 
     size_t add(int16_t x, int16_t y, float ex, float ey, float maxzoom, float placementZoom);
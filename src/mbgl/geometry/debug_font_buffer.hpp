@@ -2,11 +2,12 @@
 #define MBGL_GEOMETRY_DEBUG_FONT_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 
 namespace mbgl {
 
 class DebugFontBuffer : public Buffer<
-    4 // 2 bytes per coordinate, 2 coordinates
+    FillVertexLayout::stride // 2 bytes per coordinate, 2 coordinates
 > {
 public:
     void addText(const char *text, double left, double baseline, double scale = 1);
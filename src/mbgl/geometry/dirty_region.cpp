@@ -0,0 +1,76 @@
+#include <mbgl/geometry/dirty_region.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+namespace {
+
+// Uploading a few unchanged pixels is cheaper than an additional glTexSubImage2D call, up to a
+// point: rects are merged if their bounding box is at most this many times their combined area.
+const uint32_t maxMergeWaste = 2;
+const size_t maxRects = 32;
+
+uint32_t area(const DirtyRegion::Area& rect) {
+    return uint32_t(rect.w) * rect.h;
+}
+
+DirtyRegion::Area unite(const DirtyRegion::Area& a, const DirtyRegion::Area& b) {
+    const uint16_t x1 = std::min(a.x, b.x);
+    const uint16_t y1 = std::min(a.y, b.y);
+    const uint16_t x2 = std::max(a.x + a.w, b.x + b.w);
+    const uint16_t y2 = std::max(a.y + a.h, b.y + b.h);
+    return DirtyRegion::Area(x1, y1, x2 - x1, y2 - y1);
+}
+
+}
+
+DirtyRegion::DirtyRegion(uint16_t width_, uint16_t height_)
+    : width(width_), height(height_) {
+}
+
+void DirtyRegion::add(const Area& rect_) {
+    if (!rect_.hasArea() || rect_.x >= width || rect_.y >= height) {
+        return;
+    }
+
+    Area rect(rect_.x, rect_.y,
+              std::min<uint16_t>(rect_.w, width - rect_.x),
+              std::min<uint16_t>(rect_.h, height - rect_.y));
+
+    // Merging can make the result close enough to rects that it wasn't close to before.
+    for (auto it = rects.begin(); it != rects.end();) {
+        const Area merged = unite(*it, rect);
+        if (area(merged) <= maxMergeWaste * (area(*it) + area(rect))) {
+            rect = merged;
+            rects.erase(it);
+            it = rects.begin();
+        } else {
+            ++it;
+        }
+    }
+
+    rects.push_back(rect);
+
+    if (rects.size() > maxRects) {
+        Area bounds = rects.front();
+        for (const Area& other : rects) {
+            bounds = unite(bounds, other);
+        }
+        rects.assign(1, bounds);
+    }
+}
+
+void DirtyRegion::addAll() {
+    rects.assign(1, Area(0, 0, width, height));
+}
+
+void DirtyRegion::clear() {
+    rects.clear();
+}
+
+bool DirtyRegion::isAll() const {
+    return rects.size() == 1 && area(rects.front()) == uint32_t(width) * height;
+}
+
+}
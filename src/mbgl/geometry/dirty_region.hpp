@@ -0,0 +1,54 @@
+#ifndef MBGL_GEOMETRY_DIRTY_REGION
+#define MBGL_GEOMETRY_DIRTY_REGION
+
+#include <mbgl/util/rect.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mbgl {
+
+// Collects the parts of an atlas image that changed since the last upload, so that only those
+// have to be sent to the GPU. Rects that are close to each other are merged to save on upload
+// calls; past a certain number of rects, they collapse into their bounding box.
+class DirtyRegion {
+public:
+    typedef Rect<uint16_t> Area;
+
+    DirtyRegion(uint16_t width, uint16_t height);
+
+    void add(const Area&);
+    void addAll();
+    void clear();
+
+    bool empty() const { return rects.empty(); }
+    bool isAll() const;
+    const std::vector<Area>& getRects() const { return rects; }
+
+    // Returns the pixels of the given part of an image, tightly packed. Rows that span the
+    // entire image are already contiguous and are returned in place; otherwise they are copied
+    // into the buffer.
+    template <typename T>
+    static const T* extract(const T* image, uint16_t imageWidth, const Area& area, std::vector<T>& buffer) {
+        if (area.x == 0 && area.w == imageWidth) {
+            return image + uint32_t(area.y) * imageWidth;
+        }
+
+        buffer.resize(uint32_t(area.w) * area.h);
+        for (uint32_t y = 0; y < area.h; y++) {
+            const T* row = image + (area.y + y) * imageWidth + area.x;
+            std::copy(row, row + area.w, buffer.begin() + y * area.w);
+        }
+        return buffer.data();
+    }
+
+private:
+    const uint16_t width;
+    const uint16_t height;
+    std::vector<Area> rects;
+};
+
+}
+
+#endif
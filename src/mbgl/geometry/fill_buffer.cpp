@@ -7,7 +7,7 @@
 using namespace mbgl;
 
 void FillVertexBuffer::add(vertex_type x, vertex_type y) {
-    vertex_type *vertices = static_cast<vertex_type *>(addElement());
+    vertex_type *vertices = Layout::pos::get(addElement());
     vertices[0] = x;
     vertices[1] = y;
 }
@@ -5,6 +5,9 @@
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/platform/platform.hpp>
+#include <mbgl/renderer/gl_config.hpp>
+#include <mbgl/util/gl_object_store.hpp>
+#include <mbgl/util/thread_context.hpp>
 
 #include <cassert>
 #include <algorithm>
@@ -15,9 +18,24 @@ using namespace mbgl;
 GlyphAtlas::GlyphAtlas(uint16_t width_, uint16_t height_)
     : width(width_),
       height(height_),
-      bin(width_, height_),
+      bin(std::make_unique<BinPack<uint16_t>>(width_, height_)),
       data(std::make_unique<uint8_t[]>(width_ * height_)),
-      dirty(true) {
+      dirty(true),
+      dirtyRegion(width_, height_) {
+    stats.totalArea = uint32_t(width) * height;
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (texture) {
+        mbgl::util::ThreadContext::getGLObjectStore()->abandonTexture(texture);
+        texture = 0;
+    }
+    if (previousTexture) {
+        mbgl::util::ThreadContext::getGLObjectStore()->abandonTexture(previousTexture);
+        previousTexture = 0;
+    }
 }
 
 void GlyphAtlas::addGlyphs(uintptr_t tileUID,
@@ -28,18 +46,15 @@ void GlyphAtlas::addGlyphs(uintptr_t tileUID,
 {
     std::lock_guard<std::mutex> lock(mtx);
 
-    const std::map<uint32_t, SDFGlyph>& sdfs = fontStack.getSDFs();
-
     for (uint32_t chr : text)
     {
-        auto sdf_it = sdfs.find(chr);
-        if (sdf_it == sdfs.end()) {
+        const SDFGlyph* sdf = fontStack.getSDF(chr);
+        if (!sdf) {
             continue;
         }
 
-        const SDFGlyph& sdf = sdf_it->second;
-        Rect<uint16_t> rect = addGlyph(tileUID, stackName, sdf);
-        face.emplace(chr, Glyph{rect, sdf.metrics});
+        Rect<uint16_t> rect = addGlyph(tileUID, stackName, *sdf);
+        face.emplace(chr, Glyph{rect, sdf->metrics});
     }
 }
 
@@ -79,8 +94,13 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
     pack_width += (4 - pack_width % 4);
     pack_height += (4 - pack_height % 4);
 
-    Rect<uint16_t> rect = bin.allocate(pack_width, pack_height);
+    Rect<uint16_t> rect = bin->allocate(pack_width, pack_height);
+    if (rect.w == 0 && releasedSinceCompaction) {
+        rect = compact(pack_width, pack_height);
+    }
+
     if (rect.w == 0) {
+        stats.failures++;
         Log::Error(Event::OpenGL, "glyph bitmap overflow");
         return rect;
     }
@@ -89,6 +109,8 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
     assert(rect.y + rect.h <= height);
 
     face.emplace(glyph.id, GlyphValue { rect, tileUID });
+    stats.glyphs++;
+    stats.usedArea += uint32_t(rect.w) * rect.h;
 
     // Copy the bitmap
     const uint8_t* source = reinterpret_cast<const uint8_t*>(glyph.bitmap.data());
@@ -100,6 +122,7 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
         }
     }
 
+    dirtyRegion.add(rect);
     dirty = true;
 
     return rect;
@@ -108,6 +131,10 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
 void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
     std::lock_guard<std::mutex> lock(mtx);
 
+    // Another tile may get the same UID later.
+    relocatedTiles.erase(tileUID);
+    staleTiles.erase(tileUID);
+
     for (auto& faces : index) {
         std::map<uint32_t, GlyphValue>& face = faces.second;
         for (auto it = face.begin(); it != face.end(); /* we advance in the body */) {
@@ -126,7 +153,10 @@ void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
                     }
                 }
 
-                bin.release(rect);
+                bin->release(rect);
+                stats.glyphs--;
+                stats.usedArea -= uint32_t(rect.w) * rect.h;
+                releasedSinceCompaction = true;
 
                 // Make sure to post-increment the iterator: This will return the
                 // current iterator, but will go to the next position before we
@@ -140,13 +170,132 @@ void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
     }
 }
 
+Rect<uint16_t> GlyphAtlas::compact(uint16_t packWidth, uint16_t packHeight) {
+    releasedSinceCompaction = false;
+
+    std::vector<GlyphValue*> glyphs;
+    for (auto& face : index) {
+        for (auto& glyph : face.second) {
+            glyphs.push_back(&glyph.second);
+        }
+    }
+
+    // Packing the tallest glyphs first wastes the least space.
+    std::sort(glyphs.begin(), glyphs.end(), [](const GlyphValue* a, const GlyphValue* b) {
+        return a->rect.h != b->rect.h ? a->rect.h > b->rect.h : a->rect.w > b->rect.w;
+    });
+
+    auto packed = std::make_unique<BinPack<uint16_t>>(width, height);
+    std::vector<Rect<uint16_t>> rects;
+    rects.reserve(glyphs.size());
+
+    for (const GlyphValue* glyph : glyphs) {
+        rects.push_back(packed->allocate(glyph->rect.w, glyph->rect.h));
+        if (rects.back().w == 0) {
+            return Rect<uint16_t>{ 0, 0, 0, 0 };
+        }
+    }
+
+    const Rect<uint16_t> rect = packed->allocate(packWidth, packHeight);
+    if (rect.w == 0) {
+        return rect;
+    }
+
+    auto compacted = std::make_unique<uint8_t[]>(width * height);
+    for (size_t i = 0; i < glyphs.size(); i++) {
+        GlyphValue& glyph = *glyphs[i];
+        const Rect<uint16_t>& from = glyph.rect;
+        const Rect<uint16_t>& to = rects[i];
+
+        for (uint32_t y = 0; y < from.h; y++) {
+            const uint8_t* source = data.get() + width * (from.y + y) + from.x;
+            std::copy(source, source + from.w, compacted.get() + width * (to.y + y) + to.x);
+        }
+
+        if (to.x != from.x || to.y != from.y) {
+            for (uintptr_t tileUID : glyph.ids) {
+                relocatedTiles.insert(tileUID);
+                staleTiles[tileUID] = generation + 1;
+            }
+        }
+
+        glyph.rect = to;
+    }
+
+    data = std::move(compacted);
+    bin = std::move(packed);
+    generation++;
+    stats.compactions++;
+    dirtyRegion.addAll();
+    dirty = true;
+
+    Log::Debug(Event::OpenGL, "compacted glyph atlas: %u glyphs, %u tiles to rebuild",
+               unsigned(glyphs.size()), unsigned(relocatedTiles.size()));
+
+    return rect;
+}
+
+std::unordered_set<uintptr_t> GlyphAtlas::takeRelocatedTiles() {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    std::unordered_set<uintptr_t> tiles;
+    tiles.swap(relocatedTiles);
+    return tiles;
+}
+
+void GlyphAtlas::finishRelocation(uintptr_t tileUID, uint32_t glyphGeneration) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = staleTiles.find(tileUID);
+    if (it != staleTiles.end() && it->second <= glyphGeneration) {
+        staleTiles.erase(it);
+    }
+}
+
+bool GlyphAtlas::isRelocated(uintptr_t tileUID, uint32_t glyphGeneration) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = staleTiles.find(tileUID);
+    return it != staleTiles.end() && glyphGeneration < it->second;
+}
+
+uint32_t GlyphAtlas::getGeneration() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return generation;
+}
+
+GlyphAtlas::Stats GlyphAtlas::getStats() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+
 void GlyphAtlas::upload() {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (previousTexture && staleTiles.empty()) {
+        mbgl::util::ThreadContext::getGLObjectStore()->abandonTexture(previousTexture);
+        previousTexture = 0;
+    }
+
     if (dirty) {
+        // After a compaction, the glyphs are uploaded to a new texture. Buckets that still refer
+        // to the old positions keep using the previous one until they have been rebuilt. If the
+        // atlas is compacted again before that, they use the texture of the generation between.
+        if (textureGeneration != generation) {
+            if (previousTexture) {
+                mbgl::util::ThreadContext::getGLObjectStore()->abandonTexture(previousTexture);
+                previousTexture = 0;
+            }
+            // If nothing refers to the old positions anymore, the texture is just overwritten.
+            if (!staleTiles.empty()) {
+                std::swap(previousTexture, texture);
+            }
+            textureGeneration = generation;
+        }
+
         const bool first = !texture;
         bind();
 
-        std::lock_guard<std::mutex> lock(mtx);
-
         if (first) {
             MBGL_CHECK_ERROR(glTexImage2D(
                 GL_TEXTURE_2D, // GLenum target
@@ -160,19 +309,28 @@ void GlyphAtlas::upload() {
                 data.get() // const GLvoid* data
             ));
         } else {
-            MBGL_CHECK_ERROR(glTexSubImage2D(
-                GL_TEXTURE_2D, // GLenum target
-                0, // GLint level
-                0, // GLint xoffset
-                0, // GLint yoffset
-                width, // GLsizei width
-                height, // GLsizei height
-                GL_ALPHA, // GLenum format
-                GL_UNSIGNED_BYTE, // GLenum type
-                data.get() // const GLvoid* data
-            ));
+            // Released glyphs aren't uploaded: nothing refers to their space until it's reused.
+            for (const auto& rect : dirtyRegion.getRects()) {
+                // Rows of the uploaded pixels have to be aligned to 4 bytes (GL_UNPACK_ALIGNMENT).
+                const uint16_t x1 = rect.x & ~3;
+                const uint16_t x2 = std::min<uint16_t>(width, (rect.x + rect.w + 3) & ~3);
+                const DirtyRegion::Area area(x1, rect.y, x2 - x1, rect.h);
+
+                MBGL_CHECK_ERROR(glTexSubImage2D(
+                    GL_TEXTURE_2D, // GLenum target
+                    0, // GLint level
+                    area.x, // GLint xoffset
+                    area.y, // GLint yoffset
+                    area.w, // GLsizei width
+                    area.h, // GLsizei height
+                    GL_ALPHA, // GLenum format
+                    GL_UNSIGNED_BYTE, // GLenum type
+                    DirtyRegion::extract(data.get(), width, area, uploadBuffer) // const GLvoid* data
+                ));
+            }
         }
 
+        dirtyRegion.clear();
         dirty = false;
 
 #if defined(DEBUG)
@@ -181,10 +339,18 @@ void GlyphAtlas::upload() {
     }
 }
 
+void GlyphAtlas::bind(uintptr_t tileUID, uint32_t glyphGeneration) {
+    if (previousTexture && isRelocated(tileUID, glyphGeneration)) {
+        gl::bindTexture(previousTexture);
+    } else {
+        bind();
+    }
+}
+
 void GlyphAtlas::bind() {
     if (!texture) {
         MBGL_CHECK_ERROR(glGenTextures(1, &texture));
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+        gl::bindTexture(texture);
 #ifndef GL_ES_VERSION_2_0
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 #endif
@@ -193,6 +359,6 @@ void GlyphAtlas::bind() {
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
     } else {
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+        gl::bindTexture(texture);
     }
 };
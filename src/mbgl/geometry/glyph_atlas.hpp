@@ -2,20 +2,25 @@
 #define MBGL_GEOMETRY_GLYPH_ATLAS
 
 #include <mbgl/geometry/binpack.hpp>
+#include <mbgl/geometry/dirty_region.hpp>
 #include <mbgl/text/glyph_store.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
 #include <string>
 #include <set>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
 class GlyphAtlas : public util::noncopyable {
 public:
     GlyphAtlas(uint16_t width, uint16_t height);
+    ~GlyphAtlas();
 
     void addGlyphs(uintptr_t tileUID,
                    const std::u32string& text,
@@ -24,11 +29,46 @@ public:
                    GlyphPositions&);
     void removeGlyphs(uintptr_t tileUID);
 
+    // When the atlas runs out of space, it repacks the glyphs that are still in use, which moves
+    // glyphs that tiles have already baked into their buffers, and starts a new generation.
+    // Returns the tiles whose symbol buckets have to be rebuilt because of that.
+    std::unordered_set<uintptr_t> takeRelocatedTiles();
+
+    // Called when all symbol buckets of a relocated tile have been rebuilt with positions of at
+    // least the given generation. Until then, its older buckets use the previous texture.
+    void finishRelocation(uintptr_t tileUID, uint32_t generation);
+
+    // Whether the given tile's glyph positions of the given generation have moved since.
+    bool isRelocated(uintptr_t tileUID, uint32_t generation);
+
+    // The generation of the glyph positions that addGlyphs currently hands out.
+    uint32_t getGeneration();
+
+    struct Stats {
+        size_t glyphs = 0;
+        // In pixels, including the padding around each glyph.
+        uint32_t usedArea = 0;
+        uint32_t totalArea = 0;
+        uint32_t compactions = 0;
+        // Glyphs that didn't fit even after compacting the atlas.
+        uint32_t failures = 0;
+
+        double utilization() const {
+            return totalArea ? double(usedArea) / totalArea : 0;
+        }
+    };
+
+    Stats getStats();
+
     // Binds the atlas texture to the GPU, and uploads data if it is out of date.
     void bind();
 
+    // Binds the texture that matches the glyph positions of the given tile and generation.
+    void bind(uintptr_t tileUID, uint32_t generation);
+
     // Uploads the texture to the GPU to be available when we need it. This is a lazy operation;
-    // the texture is only bound when the data is out of date (=dirty).
+    // the texture is only bound when the data is out of date (=dirty), and only the glyphs that
+    // were added since the last upload are sent.
     void upload();
 
     const uint16_t width = 0;
@@ -46,12 +86,31 @@ private:
                             const std::string& stackName,
                             const SDFGlyph&);
 
+    // Repacks all glyphs, leaving room for a new one of the given size. Returns the space
+    // reserved for it, or an empty rect if the glyphs wouldn't fit, in which case nothing moves.
+    Rect<uint16_t> compact(uint16_t packWidth, uint16_t packHeight);
+
     std::mutex mtx;
-    BinPack<uint16_t> bin;
+    std::unique_ptr<BinPack<uint16_t>> bin;
     std::map<std::string, std::map<uint32_t, GlyphValue>> index;
-    const std::unique_ptr<uint8_t[]> data;
+    std::unique_ptr<uint8_t[]> data;
     std::atomic<bool> dirty;
+    DirtyRegion dirtyRegion;
+    std::vector<uint8_t> uploadBuffer;
     uint32_t texture = 0;
+
+    // Compacting again is pointless until glyphs have been released.
+    bool releasedSinceCompaction = false;
+    uint32_t generation = 0;
+    std::unordered_set<uintptr_t> relocatedTiles;
+
+    // Relocated tiles and the generation their buckets have to be rebuilt with. The texture
+    // with the glyph positions from before the last compaction is kept until they all are.
+    std::unordered_map<uintptr_t, uint32_t> staleTiles;
+    uint32_t previousTexture = 0;
+    uint32_t textureGeneration = 0;
+
+    Stats stats;
 };
 
 };
@@ -10,21 +10,22 @@ size_t IconVertexBuffer::add(int16_t x, int16_t y, float ox, float oy, int16_t t
     const size_t idx = index();
     void *data = addElement();
 
-    int16_t *shorts = static_cast<int16_t *>(data);
-    shorts[0] /* pos */ = x;
-    shorts[1] /* pos */ = y;
-    shorts[2] /* offset */ = std::round(ox * 64); // use 1/64 pixels for placement
-    shorts[3] /* offset */ = std::round(oy * 64);
-
-    uint8_t *ubytes = static_cast<uint8_t *>(data);
-    // a_data1
-    ubytes[8] /* tex */ = tx / 4;
-    ubytes[9] /* tex */ = ty / 4;
-    ubytes[10] /* labelminzoom */ = labelminzoom * 10;
-
-    // a_data2
-    ubytes[12] /* minzoom */ = minzoom * 10; // 1/10 zoom levels: z16 == 160.
-    ubytes[13] /* maxzoom */ = std::fmin(maxzoom, 25) * 10; // 1/10 zoom levels: z16 == 160.
+    int16_t *position = Layout::pos::get(data);
+    position[0] = x;
+    position[1] = y;
+
+    int16_t *glyphOffset = Layout::offset::get(data);
+    glyphOffset[0] = std::round(ox * 64); // use 1/64 pixels for placement
+    glyphOffset[1] = std::round(oy * 64);
+
+    uint8_t *data1 = Layout::data1::get(data);
+    data1[0] /* tex */ = tx / 4;
+    data1[1] /* tex */ = ty / 4;
+    data1[2] /* labelminzoom */ = labelminzoom * 10;
+
+    uint8_t *data2 = Layout::data2::get(data);
+    data2[0] /* minzoom */ = minzoom * 10; // 1/10 zoom levels: z16 == 160.
+    data2[1] /* maxzoom */ = std::fmin(maxzoom, 25) * 10; // 1/10 zoom levels: z16 == 160.
 
     return idx;
 }
@@ -2,15 +2,18 @@
 #define MBGL_GEOMETRY_ICON_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 
 #include <array>
 
 namespace mbgl {
 
     class IconVertexBuffer : public Buffer<
-    16
+    SymbolVertexLayout::stride
     > {
     public:
+        typedef SymbolVertexLayout Layout;
+
         size_t add(int16_t x, int16_t y, float ox, float oy, int16_t tx, int16_t ty, float minzoom, float maxzoom, float labelminzoom);
 
     };
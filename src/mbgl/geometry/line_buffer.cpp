@@ -9,15 +9,15 @@ size_t LineVertexBuffer::add(vertex_type x, vertex_type y, float ex, float ey, i
     size_t idx = index();
     void *data = addElement();
 
-    int16_t *coords = static_cast<int16_t *>(data);
+    int16_t *coords = Layout::pos::get(data);
     coords[0] = (x * 2) | tx;
     coords[1] = (y * 2) | ty;
 
-    int8_t *extrude = static_cast<int8_t *>(data);
-    extrude[4] = std::round(extrudeScale * ex);
-    extrude[5] = std::round(extrudeScale * ey);
-    extrude[6] = static_cast<int8_t>(linesofar / 128);
-    extrude[7] = static_cast<int8_t>(linesofar % 128);
+    int8_t *extrude = Layout::data::get(data);
+    extrude[0] = std::round(extrudeScale * ex);
+    extrude[1] = std::round(extrudeScale * ey);
+    extrude[2] = static_cast<int8_t>(linesofar / 128);
+    extrude[3] = static_cast<int8_t>(linesofar % 128);
 
     return idx;
 }
@@ -2,13 +2,15 @@
 #define MBGL_GEOMETRY_LINE_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 
 namespace mbgl {
 
 class LineVertexBuffer : public Buffer<
-    8 // 2 coordinates per vertex + 1 linesofar + 1 extrude coord pair == 4 (== 8 bytes)
+    LineVertexLayout::stride // 2 coordinates per vertex + 1 linesofar + 1 extrude coord pair == 4 (== 8 bytes)
 > {
 public:
+    typedef LineVertexLayout Layout;
     typedef int16_t vertex_type;
 
     /*
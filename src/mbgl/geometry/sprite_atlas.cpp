@@ -11,6 +11,7 @@
 #include <mbgl/util/thread_context.hpp>
 
 #include <mbgl/map/sprite.hpp>
+#include <mbgl/renderer/gl_config.hpp>
 
 #include <cassert>
 #include <cmath>
@@ -28,7 +29,8 @@ SpriteAtlas::SpriteAtlas(dimension width_, dimension height_, float pixelRatio_,
       store(store_),
       bin(width_, height_),
       data(std::make_unique<uint32_t[]>(pixelWidth * pixelHeight)),
-      dirty(true) {
+      dirty(true),
+      dirtyRegion(pixelWidth, pixelHeight) {
     std::fill(data.get(), data.get() + pixelWidth * pixelHeight, 0);
 }
 
@@ -154,6 +156,11 @@ void SpriteAtlas::copy(const Holder& holder, const bool wrap) {
             { dstPos.x - borderX, dstPos.y + dstPos.h, dstPos.w + border + borderX, border });
     }
 
+    // Include the borders, if any.
+    const uint32_t x1 = dstPos.x > 0 ? dstPos.x - 1 : 0;
+    const uint32_t y1 = dstPos.y > 0 ? dstPos.y - 1 : 0;
+    dirtyRegion.add({ dimension(x1), dimension(y1),
+                      dimension(dstPos.x + dstPos.w + 1 - x1), dimension(dstPos.y + dstPos.h + 1 - y1) });
     dirty = true;
 }
 
@@ -194,7 +201,7 @@ void SpriteAtlas::updateDirty() {
 void SpriteAtlas::bind(bool linear) {
     if (!texture) {
         MBGL_CHECK_ERROR(glGenTextures(1, &texture));
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+        gl::bindTexture(texture);
 #ifndef GL_ES_VERSION_2_0
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 #endif
@@ -204,7 +211,7 @@ void SpriteAtlas::bind(bool linear) {
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
         fullUploadRequired = true;
     } else {
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+        gl::bindTexture(texture);
     }
 
     GLuint filter_val = linear ? GL_LINEAR : GL_NEAREST;
@@ -231,19 +238,22 @@ void SpriteAtlas::bind(bool linear) {
             ));
             fullUploadRequired = false;
         } else {
-            MBGL_CHECK_ERROR(glTexSubImage2D(
-                GL_TEXTURE_2D, // GLenum target
-                0, // GLint level
-                0, // GLint xoffset
-                0, // GLint yoffset
-                pixelWidth, // GLsizei width
-                pixelHeight, // GLsizei height
-                GL_RGBA, // GLenum format
-                GL_UNSIGNED_BYTE, // GLenum type
-                data.get() // const GLvoid *pixels
-            ));
+            for (const auto& rect : dirtyRegion.getRects()) {
+                MBGL_CHECK_ERROR(glTexSubImage2D(
+                    GL_TEXTURE_2D, // GLenum target
+                    0, // GLint level
+                    rect.x, // GLint xoffset
+                    rect.y, // GLint yoffset
+                    rect.w, // GLsizei width
+                    rect.h, // GLsizei height
+                    GL_RGBA, // GLenum format
+                    GL_UNSIGNED_BYTE, // GLenum type
+                    DirtyRegion::extract(data.get(), pixelWidth, rect, uploadBuffer) // const GLvoid *pixels
+                ));
+            }
         }
 
+        dirtyRegion.clear();
         dirty = false;
 
 #ifndef GL_ES_VERSION_2_0
@@ -2,6 +2,7 @@
 #define MBGL_GEOMETRY_SPRITE_ATLAS
 
 #include <mbgl/geometry/binpack.hpp>
+#include <mbgl/geometry/dirty_region.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/ptr.hpp>
@@ -12,6 +13,7 @@
 #include <atomic>
 #include <set>
 #include <array>
+#include <vector>
 
 namespace mbgl {
 
@@ -92,6 +94,8 @@ private:
     std::set<std::string> uninitialized;
     const std::unique_ptr<uint32_t[]> data;
     std::atomic<bool> dirty;
+    DirtyRegion dirtyRegion;
+    std::vector<uint32_t> uploadBuffer;
     bool fullUploadRequired = true;
     uint32_t texture = 0;
     uint32_t filter = 0;
@@ -2,6 +2,7 @@
 #define MBGL_GEOMETRY_STATIC_VERTEX_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 
 #include <vector>
 #include <cstddef>
@@ -11,7 +12,7 @@
 namespace mbgl {
 
 class StaticVertexBuffer : public Buffer<
-    4, // bytes per vertex (2 * signed short == 4 bytes)
+    FillVertexLayout::stride, // bytes per vertex (2 * signed short == 4 bytes)
     GL_ARRAY_BUFFER,
     32 // default length
 > {
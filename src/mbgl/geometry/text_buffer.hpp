@@ -2,16 +2,18 @@
 #define MBGL_GEOMETRY_TEXT_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 #include <array>
 
 namespace mbgl {
 
 class TextVertexBuffer : public Buffer <
-    16,
+    SymbolVertexLayout::stride,
     GL_ARRAY_BUFFER,
     32768
 > {
 public:
+    typedef SymbolVertexLayout Layout;
     typedef int16_t vertex_type;
 
     size_t add(int16_t x, int16_t y, float ox, float oy, uint16_t tx, uint16_t ty, float minzoom, float maxzoom, float labelminzoom);
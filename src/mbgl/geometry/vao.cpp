@@ -1,4 +1,5 @@
 #include <mbgl/geometry/vao.hpp>
+#include <mbgl/renderer/gl_config.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/util/gl_object_store.hpp>
 #include <mbgl/util/string.hpp>
@@ -32,9 +33,14 @@ static gl::ExtensionFunction<
         {"GL_APPLE_vertex_array_object", "glGenVertexArraysAPPLE"}
     });
 
+void VertexArrayObject::Bind(GLuint array) {
+    if (!BindVertexArray) return;
+    MBGL_CHECK_ERROR(BindVertexArray(array));
+}
+
 void VertexArrayObject::Unbind() {
     if (!BindVertexArray) return;
-    MBGL_CHECK_ERROR(BindVertexArray(0));
+    gl::bindVertexArray(0);
 }
 
 void VertexArrayObject::Delete(GLsizei n, const GLuint* arrays) {
@@ -65,7 +71,7 @@ void VertexArrayObject::bindVertexArrayObject() {
     if (!vao) {
         MBGL_CHECK_ERROR(GenVertexArrays(1, &vao));
     }
-    MBGL_CHECK_ERROR(BindVertexArray(vao));
+    gl::bindVertexArray(vao);
 }
 
 void VertexArrayObject::verifyBinding(Shader &shader, GLuint vertexBuffer, GLuint elementsBuffer,
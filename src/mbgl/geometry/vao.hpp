@@ -11,6 +11,7 @@ namespace mbgl {
 
 class VertexArrayObject : public util::noncopyable {
 public:
+    static void Bind(GLuint array);
     static void Unbind();
     static void Delete(GLsizei n, const GLuint* arrays);
 
@@ -22,7 +23,7 @@ public:
         bindVertexArrayObject();
         if (bound_shader == 0) {
             vertexBuffer.bind();
-            shader.bind(offset);
+            shader.bind(offset + vertexBuffer.getOffset());
             if (vao) {
                 storeBinding(shader, vertexBuffer.getID(), 0, offset);
             }
@@ -37,7 +38,7 @@ public:
         if (bound_shader == 0) {
             vertexBuffer.bind();
             elementsBuffer.bind();
-            shader.bind(offset);
+            shader.bind(offset + vertexBuffer.getOffset());
             if (vao) {
                 storeBinding(shader, vertexBuffer.getID(), elementsBuffer.getID(), offset);
             }
@@ -0,0 +1,80 @@
+#ifndef MBGL_GEOMETRY_VERTEX_LAYOUT
+#define MBGL_GEOMETRY_VERTEX_LAYOUT
+
+#include <mbgl/platform/gl.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+template <typename T> struct VertexAttributeType;
+template <> struct VertexAttributeType<int8_t>   { static constexpr GLenum value = GL_BYTE; };
+template <> struct VertexAttributeType<uint8_t>  { static constexpr GLenum value = GL_UNSIGNED_BYTE; };
+template <> struct VertexAttributeType<int16_t>  { static constexpr GLenum value = GL_SHORT; };
+template <> struct VertexAttributeType<uint16_t> { static constexpr GLenum value = GL_UNSIGNED_SHORT; };
+template <> struct VertexAttributeType<float>    { static constexpr GLenum value = GL_FLOAT; };
+
+// A single attribute of an interleaved vertex: `count` components of type T,
+// starting `offset` bytes into the vertex.
+template <typename T, size_t count_, size_t offset_, bool normalized_ = false>
+struct VertexAttribute {
+    typedef T value_type;
+
+    static constexpr size_t count = count_;
+    static constexpr size_t offset = offset_;
+    static constexpr size_t size = sizeof(T) * count_;
+    static constexpr GLenum type = VertexAttributeType<T>::value;
+    static constexpr bool normalized = normalized_;
+
+    // Returns a pointer to the first component of this attribute in the vertex at `vertex`.
+    static inline T *get(void *vertex) {
+        return reinterpret_cast<T *>(static_cast<char *>(vertex) + offset);
+    }
+};
+
+// Describes the memory layout of one vertex. Buffers use `stride` as their item size and write
+// their fields through the attributes; shaders bind their attribute locations through the same
+// description, so changing a packing only has to happen in one place.
+template <size_t stride_>
+struct VertexLayout {
+    static constexpr size_t stride = stride_;
+
+    template <typename Attribute>
+    static inline void bind(int32_t location, char *offset) {
+        static_assert(Attribute::offset + Attribute::size <= stride_, "attribute exceeds vertex stride");
+        MBGL_CHECK_ERROR(glEnableVertexAttribArray(location));
+        MBGL_CHECK_ERROR(glVertexAttribPointer(location, Attribute::count, Attribute::type,
+                                               Attribute::normalized, stride_, offset + Attribute::offset));
+    }
+};
+
+// Fill, outline, pattern, raster, background and debug geometry: a single position.
+struct FillVertexLayout : VertexLayout<4> {
+    typedef VertexAttribute<int16_t, 2, 0> pos;
+};
+
+// Lines: the texture normal is packed into the lowest bit of each position coordinate. a_data
+// holds the extrusion vector (scaled by LineVertexBuffer::extrudeScale) and the line distance.
+struct LineVertexLayout : VertexLayout<8> {
+    typedef VertexAttribute<int16_t, 2, 0> pos;
+    typedef VertexAttribute<int8_t, 4, 4> data;
+};
+
+// Text and icons: anchor position, glyph offset in 1/64 pixels, texture position and zoom ranges.
+struct SymbolVertexLayout : VertexLayout<16> {
+    typedef VertexAttribute<int16_t, 2, 0> pos;
+    typedef VertexAttribute<int16_t, 2, 4> offset;
+    typedef VertexAttribute<uint8_t, 4, 8> data1;
+    typedef VertexAttribute<uint8_t, 4, 12> data2;
+};
+
+struct CollisionBoxVertexLayout : VertexLayout<12> {
+    typedef VertexAttribute<int16_t, 2, 0> pos;
+    typedef VertexAttribute<int16_t, 2, 4> extrude;
+    typedef VertexAttribute<uint8_t, 2, 8> data;
+};
+
+}
+
+#endif
@@ -395,6 +395,19 @@ bool Map::isFullyLoaded() const {
     return context->invokeSync<bool>(&MapContext::isLoaded);
 }
 
+void Map::setFrameProfiling(bool value) {
+    data->setFrameProfiling(value);
+    update();
+}
+
+bool Map::getFrameProfiling() const {
+    return data->getFrameProfiling();
+}
+
+FrameStatistics Map::getFrameStatistics() const {
+    return context->invokeSync<FrameStatistics>(&MapContext::getFrameStatistics);
+}
+
 void Map::addClass(const std::string& klass) {
     if (data->addClass(klass)) {
         update(Update::Classes);
@@ -420,6 +433,15 @@ std::vector<std::string> Map::getClasses() const {
     return data->getClasses();
 }
 
+void Map::setPaintProperty(const std::string& layer, const std::string& name, const std::string& value,
+                           const std::string& klass) {
+    context->invoke(&MapContext::setPaintProperty, layer, name, value, klass);
+}
+
+void Map::setLayoutProperty(const std::string& layer, const std::string& name, const std::string& value) {
+    context->invoke(&MapContext::setLayoutProperty, layer, name, value);
+}
+
 void Map::setDefaultTransitionDuration(const Duration& duration) {
     data->setDefaultTransitionDuration(duration);
     update(Update::DefaultTransition);
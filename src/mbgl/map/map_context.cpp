@@ -39,6 +39,7 @@ MapContext::MapContext(View& view_, FileSource& fileSource, MapData& data_)
 
     util::ThreadContext::setFileSource(&fileSource);
     util::ThreadContext::setGLObjectStore(&glObjectStore);
+    util::ThreadContext::setBufferArena(&bufferArena);
 
     asyncUpdate->unref();
 
@@ -64,6 +65,7 @@ void MapContext::cleanup() {
     style.reset();
     painter.reset();
     texturePool.reset();
+    bufferArena.clear();
 
     glObjectStore.performCleanup();
 
@@ -122,11 +124,38 @@ void MapContext::setStyleJSON(const std::string& json, const std::string& base)
     styleURL.clear();
     styleJSON = json;
 
+    // Editing the current style only updates the sources, layers and properties that changed.
+    if (style && style->diffJSON(json)) {
+        updated |= static_cast<UpdateType>(Update::Classes);
+        updated |= static_cast<UpdateType>(Update::Zoom);
+        asyncUpdate->send();
+        return;
+    }
+
     style = std::make_unique<Style>(data, asyncUpdate->get()->loop);
 
     loadStyleJSON(json, base);
 }
 
+void MapContext::setPaintProperty(const std::string& layer, const std::string& name, const std::string& value,
+                                  const std::string& klass) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+
+    if (style && style->setPaintProperty(layer, name, value, klass)) {
+        updated |= static_cast<UpdateType>(Update::Classes);
+        asyncUpdate->send();
+    }
+}
+
+void MapContext::setLayoutProperty(const std::string& layer, const std::string& name, const std::string& value) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+
+    if (style && style->setLayoutProperty(layer, name, value)) {
+        updated |= static_cast<UpdateType>(Update::Zoom);
+        asyncUpdate->send();
+    }
+}
+
 void MapContext::loadStyleJSON(const std::string& json, const std::string& base) {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
 
@@ -159,7 +188,7 @@ void MapContext::updateAnnotationTiles(const std::unordered_set<TileID, TileID::
 
     // grab existing, single shape annotations source
     const auto& shapeID = AnnotationManager::ShapeLayerID;
-    Source* shapeAnnotationSource = style->getSource(shapeID);
+    Source* shapeAnnotationSource = style->getSource(InternedString(shapeID));
 
     // Style not parsed yet
     if (!shapeAnnotationSource) {
@@ -222,8 +251,8 @@ void MapContext::updateAnnotationTiles(const std::unordered_set<TileID, TileID::
 
             // create shape bucket & connect to source
             util::ptr<StyleBucket> shapeBucket = std::make_shared<StyleBucket>(shapeLayer->type);
-            shapeBucket->name = shapeLayer->id;
-            shapeBucket->source = shapeID;
+            shapeBucket->name = InternedString(shapeLayer->id);
+            shapeBucket->source = InternedString(shapeID);
             shapeBucket->source_layer = shapeLayer->id;
 
             // apply line layout properties to bucket
@@ -347,6 +376,11 @@ MapContext::RenderResult MapContext::renderSync(const TransformState& state, con
     };
 }
 
+FrameStatistics MapContext::getFrameStatistics() const {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    return painter ? painter->getFrameStatistics() : FrameStatistics();
+}
+
 bool MapContext::isLoaded() const {
     return style->isLoaded();
 }
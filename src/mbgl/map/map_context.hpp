@@ -4,7 +4,9 @@
 #include <mbgl/map/tile_id.hpp>
 #include <mbgl/map/update.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/map/frame_statistics.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/geometry/buffer_arena.hpp>
 #include <mbgl/util/gl_object_store.hpp>
 #include <mbgl/util/ptr.hpp>
 
@@ -52,11 +54,16 @@ public:
 
     void setStyleURL(const std::string&);
     void setStyleJSON(const std::string& json, const std::string& base);
+    void setPaintProperty(const std::string& layer, const std::string& name, const std::string& value,
+                          const std::string& klass);
+    void setLayoutProperty(const std::string& layer, const std::string& name, const std::string& value);
     std::string getStyleURL() const { return styleURL; }
     std::string getStyleJSON() const { return styleJSON; }
 
     bool isLoaded() const;
 
+    FrameStatistics getFrameStatistics() const;
+
     double getTopOffsetPixelsForAnnotationSymbol(const std::string& symbol);
     void updateAnnotationTiles(const std::unordered_set<TileID, TileID::Hash>&);
 
@@ -82,6 +89,7 @@ private:
     MapData& data;
 
     util::GLObjectStore glObjectStore;
+    BufferArena bufferArena;
 
     UpdateType updated { static_cast<UpdateType>(Update::Nothing) };
     std::unique_ptr<uv::async> asyncUpdate;
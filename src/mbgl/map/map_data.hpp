@@ -68,6 +68,13 @@ public:
         collisionDebug = value;
     }
 
+    inline bool getFrameProfiling() const {
+        return frameProfiling;
+    }
+    inline void setFrameProfiling(bool value) {
+        frameProfiling = value;
+    }
+
     inline TimePoint getAnimationTime() const {
         // We're casting the TimePoint to and from a Duration because libstdc++
         // has a bug that doesn't allow TimePoints to be atomic.
@@ -120,6 +127,7 @@ private:
     std::vector<std::string> classes;
     std::atomic<uint8_t> debug { false };
     std::atomic<uint8_t> collisionDebug { false };
+    std::atomic<uint8_t> frameProfiling { false };
     std::atomic<Duration> animationTime;
     std::atomic<Duration> defaultFadeDuration;
     std::atomic<Duration> defaultTransitionDuration;
@@ -26,6 +26,7 @@
 #include <mbgl/gl/debugging.hpp>
 
 #include <algorithm>
+#include <atomic>
 
 namespace mbgl {
 
@@ -116,7 +117,9 @@ std::string SourceInfo::tileURL(const TileID& id, float pixelRatio) const {
     return result;
 }
 
-Source::Source() {}
+Source::Source() {
+    bumpGeneration();
+}
 
 Source::~Source() {
     if (req) {
@@ -257,6 +260,7 @@ TileData::State Source::addTile(MapData& data,
     }
 
     auto pos = tiles.emplace(id, std::make_unique<Tile>(id));
+    bumpGeneration();
 
     Tile& new_tile = *pos.first->second;
 
@@ -528,13 +532,52 @@ void Source::invalidateTiles(const std::unordered_set<TileID, TileID::Hash>& ids
     updateTilePtrs();
 }
 
+void Source::invalidateBucket(const InternedString& name) {
+    // Cached tiles aren't in tile_data and would come back with the old bucket.
+    cache.clear();
+
+    for (const auto& pair : tile_data) {
+        VectorTileData* data = dynamic_cast<VectorTileData*>(pair.second.lock().get());
+        if (data) {
+            data->invalidateBucket(name);
+        }
+    }
+}
+
+void Source::invalidateGlyphTiles(const std::unordered_set<uintptr_t>& glyphAtlasUIDs) {
+    // Cached tiles aren't in tile_data and would come back with the old glyph positions.
+    cache.remove([&](const TileData& tile) {
+        const VectorTileData* data = dynamic_cast<const VectorTileData*>(&tile);
+        return data && glyphAtlasUIDs.count(data->getGlyphAtlasUID());
+    });
+
+    for (const auto& pair : tile_data) {
+        VectorTileData* data = dynamic_cast<VectorTileData*>(pair.second.lock().get());
+        if (data && glyphAtlasUIDs.count(data->getGlyphAtlasUID())) {
+            data->invalidateGlyphs();
+        }
+    }
+}
+
 void Source::updateTilePtrs() {
-    tilePtrs.clear();
+    std::vector<Tile*> ptrs;
+    ptrs.reserve(tiles.size());
     for (const auto& pair : tiles) {
-        tilePtrs.push_back(pair.second.get());
+        ptrs.push_back(pair.second.get());
+    }
+
+    // New tiles bump the generation when they are added, so an unchanged list has the same tiles.
+    if (ptrs != tilePtrs) {
+        tilePtrs = std::move(ptrs);
+        bumpGeneration();
     }
 }
 
+void Source::bumpGeneration() {
+    static std::atomic<uint64_t> nextGeneration { 0 };
+    generation = ++nextGeneration;
+}
+
 void Source::setCacheSize(size_t size) {
     cache.setSize(size);
 }
@@ -583,12 +626,16 @@ void Source::emitSourceLoadingFailed(const std::string& message) {
 }
 
 void Source::emitTileLoaded(bool isNewTile) {
+    bumpGeneration();
+
     if (observer_) {
         observer_->onTileLoaded(isNewTile);
     }
 }
 
 void Source::emitTileLoadingFailed(const std::string& message) {
+    bumpGeneration();
+
     if (!observer_) {
         return;
     }
@@ -6,6 +6,7 @@
 #include <mbgl/map/tile_cache.hpp>
 #include <mbgl/style/types.hpp>
 
+#include <mbgl/util/interned_string.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/ptr.hpp>
@@ -42,7 +43,7 @@ public:
     std::string attribution;
     std::array<float, 3> center = {{0, 0, 0}};
     std::array<float, 4> bounds = {{-180, -90, 180, 90}};
-    std::string source_id = "";
+    InternedString source_id;
 
     void parseTileJSONProperties(const rapidjson::Value&);
     std::string tileURL(const TileID& id, float pixelRatio) const;
@@ -79,6 +80,13 @@ public:
 
     void invalidateTiles(const std::unordered_set<TileID, TileID::Hash>&);
 
+    // Makes the vector tiles parse the bucket with the given name again, keeping their other buckets.
+    void invalidateBucket(const InternedString& name);
+
+    // Makes the vector tiles with the given GlyphAtlas UIDs rebuild their symbol buckets, because
+    // their glyphs moved. The tiles keep rendering their old buckets until then.
+    void invalidateGlyphTiles(const std::unordered_set<uintptr_t>& glyphAtlasUIDs);
+
     void updateMatrices(const mat4 &projMatrix, const TransformState &transform);
     void drawClippingMasks(Painter &painter);
     void finishRender(Painter &painter);
@@ -86,6 +94,11 @@ public:
     std::forward_list<Tile *> getLoadedTiles() const;
     const std::vector<Tile*>& getTiles() const;
 
+    // Changes whenever tiles are added or removed, or finish loading or parsing, i.e. whenever
+    // the tiles or their buckets may be different. Values are unique among all sources, so a
+    // source that replaces another one never continues its sequence.
+    uint64_t getGeneration() const { return generation; }
+
     void setCacheSize(size_t);
     void onLowMemory();
 
@@ -116,6 +129,7 @@ private:
 
     TileData::State hasTile(const TileID& id);
     void updateTilePtrs();
+    void bumpGeneration();
 
     double getZoom(const TransformState &state) const;
 
@@ -131,6 +145,8 @@ private:
 
     Request* req = nullptr;
     Observer* observer_ = nullptr;
+
+    uint64_t generation;
 };
 
 }
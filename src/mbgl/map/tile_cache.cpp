@@ -61,4 +61,17 @@ void TileCache::clear() {
     tiles.clear();
 }
 
+void TileCache::remove(const std::function<bool (const TileData&)>& predicate) {
+    for (auto it = orderedKeys.begin(); it != orderedKeys.end();) {
+        auto tile = tiles.find(*it);
+        assert(tile != tiles.end());
+        if (predicate(*tile->second)) {
+            tiles.erase(tile);
+            it = orderedKeys.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 };
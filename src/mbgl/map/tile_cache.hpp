@@ -3,6 +3,7 @@
 
 #include <mbgl/map/tile_data.hpp>
 
+#include <functional>
 #include <list>
 #include <unordered_map>
 
@@ -18,6 +19,9 @@ public:
     std::shared_ptr<TileData> get(uint64_t key);
     bool has(uint64_t key);
     void clear();
+
+    // Drops the cached tiles for which the predicate returns true.
+    void remove(const std::function<bool (const TileData&)>& predicate);
 private:
     std::unordered_map<uint64_t, std::shared_ptr<TileData>> tiles;
     std::list<uint64_t> orderedKeys;
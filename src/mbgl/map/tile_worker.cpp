@@ -12,7 +12,7 @@
 using namespace mbgl;
 
 TileWorker::TileWorker(TileID id_,
-                       std::string sourceID_,
+                       InternedString sourceID_,
                        const uint16_t maxZoom_,
                        Style& style_,
                        std::vector<util::ptr<StyleLayer>> layers_,
@@ -35,9 +35,12 @@ TileWorker::~TileWorker() {
 Bucket* TileWorker::getBucket(const StyleLayer& layer) const {
     std::lock_guard<std::mutex> lock(bucketsMutex);
 
-    const auto it = buckets.find(layer.bucket->name);
+    auto it = buckets.find(layer.bucket->name);
     if (it == buckets.end()) {
-        return nullptr;
+        it = staleBuckets.find(layer.bucket->name);
+        if (it == staleBuckets.end()) {
+            return nullptr;
+        }
     }
 
     assert(it->second);
@@ -51,9 +54,66 @@ TileParseResult TileWorker::parse(const GeometryTile& geometryTile) {
         parseLayer(*layer, geometryTile);
     }
 
+    if (redoPlacementAfterParse && !partialParse) {
+        redoPlacementAfterParse = false;
+        placementRedone = true;
+
+        collision->reset(collision->angle, 0);
+        std::lock_guard<std::mutex> lock(bucketsMutex);
+        for (const auto& layer : layers) {
+            if (!layer->bucket) continue;
+            auto it = buckets.find(layer->bucket->name);
+            if (it != buckets.end()) {
+                it->second->placeFeatures();
+            }
+        }
+    }
+
     return partialParse ? TileData::State::partial : TileData::State::parsed;
 }
 
+void TileWorker::invalidateBuckets(const std::unordered_set<InternedString>& names) {
+    for (const auto& layer : layers) {
+        if (layer->bucket && layer->bucket->type == StyleLayerType::Symbol && names.count(layer->bucket->name)) {
+            redoPlacementAfterParse = true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(bucketsMutex);
+    for (const auto& name : names) {
+        pendingSymbolBuckets.erase(name);
+
+        auto it = buckets.find(name);
+        if (it != buckets.end()) {
+            staleBuckets[name] = std::move(it->second);
+            buckets.erase(it);
+        }
+    }
+
+    layers = style.layers;
+}
+
+void TileWorker::finishParse(TileData::State result) {
+    std::lock_guard<std::mutex> lock(bucketsMutex);
+
+    for (auto it = staleBuckets.begin(); it != staleBuckets.end();) {
+        // Buckets that the tile doesn't have anymore, e.g. because they are hidden now, are
+        // only removed once the tile is parsed completely.
+        if (buckets.count(it->first) || result != TileData::State::partial) {
+            it = staleBuckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (placementRedone) {
+        placementRedone = false;
+        for (const auto& pair : buckets) {
+            pair.second->swapRenderData();
+        }
+    }
+}
+
 void TileWorker::redoPlacement(float angle, bool collisionDebug) {
     collision->reset(angle, 0);
     collision->setDebug(collisionDebug);
@@ -76,7 +136,7 @@ struct PropertyEvaluator {
     }
 
     T operator()(const Function<T> &value) const {
-        return mapbox::util::apply_visitor(FunctionEvaluator<T>(z), value);
+        return evaluateFunction(value, z);
     }
 
     template <typename P, typename std::enable_if<!std::is_convertible<P, T>::value, int>::type = 0>
@@ -112,8 +172,11 @@ void TileWorker::parseLayer(const StyleLayer& layer, const GeometryTile& geometr
     }
 
     // This is a singular layer. Check if this bucket already exists.
-    if (getBucket(layer))
-        return;
+    {
+        std::lock_guard<std::mutex> lock(bucketsMutex);
+        if (buckets.count(layer.bucket->name))
+            return;
+    }
 
     const StyleBucket& styleBucket = *layer.bucket;
 
@@ -205,6 +268,37 @@ std::unique_ptr<Bucket> TileWorker::createLineBucket(const GeometryTileLayer& la
 
 std::unique_ptr<Bucket> TileWorker::createSymbolBucket(const GeometryTileLayer& layer,
                                                        const StyleBucket& bucket_desc) {
+    std::unique_ptr<SymbolBucket> bucket;
+
+    auto it = pendingSymbolBuckets.find(bucket_desc.name);
+    if (it != pendingSymbolBuckets.end()) {
+        bucket = std::move(it->second);
+        pendingSymbolBuckets.erase(it);
+    } else {
+        bucket = prepareSymbolBucket(layer, bucket_desc);
+    }
+
+    if (bucket->needsDependencies(*style.glyphStore, *style.sprite)) {
+        partialParse = true;
+    }
+
+    // We do not proceed if the parser is in a "partial" state because
+    // the layer ordering needs to be respected when calculating text
+    // collisions. Although, at this point, we requested all the resources
+    // needed by this tile.
+    if (partialParse) {
+        pendingSymbolBuckets.emplace(bucket_desc.name, std::move(bucket));
+        return nullptr;
+    }
+
+    bucket->addFeatures(reinterpret_cast<uintptr_t>(this), *style.spriteAtlas, *style.glyphAtlas,
+                        *style.glyphStore);
+
+    return bucket->hasData() ? std::move(bucket) : nullptr;
+}
+
+std::unique_ptr<SymbolBucket> TileWorker::prepareSymbolBucket(const GeometryTileLayer& layer,
+                                                              const StyleBucket& bucket_desc) {
     auto bucket = std::make_unique<SymbolBucket>(*collision, id.overscaling);
 
     const float z = id.z;
@@ -248,20 +342,7 @@ std::unique_ptr<Bucket> TileWorker::createSymbolBucket(const GeometryTileLayer&
     applyLayoutProperty(PropertyKey::TextOffset, bucket_desc.layout, layout.text.offset, z);
     applyLayoutProperty(PropertyKey::TextAllowOverlap, bucket_desc.layout, layout.text.allow_overlap, z);
 
-    if (bucket->needsDependencies(layer, bucket_desc.filter, *style.glyphStore, *style.sprite)) {
-        partialParse = true;
-    }
+    bucket->parseFeatures(layer, bucket_desc.filter);
 
-    // We do not proceed if the parser is in a "partial" state because
-    // the layer ordering needs to be respected when calculating text
-    // collisions. Although, at this point, we requested all the resources
-    // needed by this tile.
-    if (partialParse) {
-        return nullptr;
-    }
-
-    bucket->addFeatures(reinterpret_cast<uintptr_t>(this), *style.spriteAtlas, *style.glyphAtlas,
-                        *style.glyphStore);
-
-    return bucket->hasData() ? std::move(bucket) : nullptr;
+    return bucket;
 }
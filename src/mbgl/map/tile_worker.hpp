@@ -6,6 +6,7 @@
 #include <mbgl/geometry/elements_buffer.hpp>
 #include <mbgl/geometry/fill_buffer.hpp>
 #include <mbgl/geometry/line_buffer.hpp>
+#include <mbgl/util/interned_string.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/style/filter_expression.hpp>
@@ -14,6 +15,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -21,6 +23,7 @@ class CollisionTile;
 class GeometryTile;
 class Style;
 class Bucket;
+class SymbolBucket;
 class StyleLayer;
 class StyleBucket;
 class GeometryTileLayer;
@@ -32,7 +35,7 @@ using TileParseResult = mapbox::util::variant<
 class TileWorker : public util::noncopyable {
 public:
     TileWorker(TileID,
-               std::string sourceID,
+               InternedString sourceID,
                uint16_t maxZoom,
                Style&,
                std::vector<util::ptr<StyleLayer>>,
@@ -45,6 +48,14 @@ public:
     TileParseResult parse(const GeometryTile&);
     void redoPlacement(float angle, bool collisionDebug);
 
+    // Makes the next parse create the given buckets again, with the current layers of the style.
+    // The old buckets are still rendered until then. Must not be called while parsing.
+    void invalidateBuckets(const std::unordered_set<InternedString>& names);
+
+    // Releases the old buckets that the last parse replaced, and swaps in the labels of the
+    // buckets that it placed again. Must be called on the thread that renders the buckets.
+    void finishParse(TileData::State);
+
     std::vector<util::ptr<StyleLayer>> layers;
 
 private:
@@ -53,12 +64,13 @@ private:
     std::unique_ptr<Bucket> createFillBucket(const GeometryTileLayer&, const StyleBucket&);
     std::unique_ptr<Bucket> createLineBucket(const GeometryTileLayer&, const StyleBucket&);
     std::unique_ptr<Bucket> createSymbolBucket(const GeometryTileLayer&, const StyleBucket&);
+    std::unique_ptr<SymbolBucket> prepareSymbolBucket(const GeometryTileLayer&, const StyleBucket&);
 
     template <class Bucket>
     void addBucketGeometries(Bucket&, const GeometryTileLayer&, const FilterExpression&);
 
     const TileID id;
-    const std::string sourceID;
+    const InternedString sourceID;
     const uint16_t maxZoom;
 
     Style& style;
@@ -66,6 +78,11 @@ private:
 
     bool partialParse = false;
 
+    // Set when a symbol bucket was invalidated; its old labels have to be removed from the
+    // collision tile by placing all labels again.
+    bool redoPlacementAfterParse = false;
+    bool placementRedone = false;
+
     FillVertexBuffer fillVertexBuffer;
     LineVertexBuffer lineVertexBuffer;
 
@@ -74,12 +91,17 @@ private:
 
     std::unique_ptr<CollisionTile> collision;
 
+    // Symbol buckets of a partially parsed tile. They keep the features and labels they
+    // extracted, so that a reparse only has to shape and place them.
+    std::unordered_map<InternedString, std::unique_ptr<SymbolBucket>> pendingSymbolBuckets;
+
     // Contains all the Bucket objects for the tile. Buckets are render
     // objects and they get added to this map as they get processed.
     // Tiles partially parsed can get new buckets at any moment but are
     // also fit for rendering. That said, access to this list needs locking
     // unless the tile is completely parsed.
-    std::unordered_map<std::string, std::unique_ptr<Bucket>> buckets;
+    std::unordered_map<InternedString, std::unique_ptr<Bucket>> buckets;
+    std::unordered_map<InternedString, std::unique_ptr<Bucket>> staleBuckets;
     mutable std::mutex bucketsMutex;
 };
 
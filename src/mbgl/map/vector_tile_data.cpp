@@ -9,6 +9,9 @@
 #include <mbgl/util/worker.hpp>
 #include <mbgl/util/work_request.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/geometry/glyph_atlas.hpp>
+
+#include <sstream>
 
 using namespace mbgl;
 
@@ -19,6 +22,7 @@ VectorTileData::VectorTileData(const TileID& id_,
                                bool collisionDebug)
     : TileData(id_),
       worker(style_.workers),
+      glyphAtlas(*style_.glyphAtlas),
       tileWorker(id_,
                  source_.source_id,
                  source_.max_zoom,
@@ -62,12 +66,23 @@ void VectorTileData::request(float pixelRatio, const std::function<void()>& call
 }
 
 bool VectorTileData::reparse(std::function<void()> callback) {
-    if (parsing || (state != State::loaded && state != State::partial)) {
+    if (parsing || redoingPlacement || (state != State::loaded && state != State::partial)) {
         return false;
     }
 
     parsing = true;
 
+    if (!invalidatedBuckets.empty()) {
+        tileWorker.invalidateBuckets(invalidatedBuckets);
+        invalidatedBuckets.clear();
+    }
+
+    if (glyphsInvalidated) {
+        glyphsInvalidated = false;
+        rebuildingGlyphs = true;
+        glyphGeneration = glyphAtlas.getGeneration();
+    }
+
     workRequest = worker.parseVectorTile(tileWorker, data, [this, callback] (TileParseResult result) {
         parsing = false;
 
@@ -77,6 +92,18 @@ bool VectorTileData::reparse(std::function<void()> callback) {
 
         if (result.is<State>()) {
             state = result.get<State>();
+            tileWorker.finishParse(state);
+
+            // Buckets may have been invalidated while the tile was parsing.
+            if (state == State::parsed && !invalidatedBuckets.empty()) {
+                state = State::partial;
+            }
+
+            // The symbol buckets don't refer to the glyphs from before the compaction anymore.
+            if (state == State::parsed && rebuildingGlyphs) {
+                glyphAtlas.finishRelocation(getGlyphAtlasUID(), glyphGeneration);
+                rebuildingGlyphs = false;
+            }
         } else {
             std::stringstream message;
             message <<  "Failed to parse [" << std::string(id) << "]: " << result.get<std::string>();
@@ -90,6 +117,25 @@ bool VectorTileData::reparse(std::function<void()> callback) {
     return true;
 }
 
+void VectorTileData::invalidateBucket(const InternedString& name) {
+    invalidatedBuckets.insert(name);
+
+    // Partial tiles are reparsed when the style changes.
+    if (state == State::parsed) {
+        state = State::partial;
+    }
+}
+
+void VectorTileData::invalidateGlyphs() {
+    for (const auto& layer : tileWorker.layers) {
+        if (layer->bucket && layer->bucket->type == StyleLayerType::Symbol) {
+            invalidateBucket(layer->bucket->name);
+        }
+    }
+
+    glyphsInvalidated = true;
+}
+
 Bucket* VectorTileData::getBucket(const StyleLayer& layer) {
     if (!isReady() || !layer.bucket) {
         return nullptr;
@@ -5,11 +5,13 @@
 #include <mbgl/map/tile_worker.hpp>
 
 #include <atomic>
+#include <unordered_set>
 
 namespace mbgl {
 
 class Style;
 class SourceInfo;
+class GlyphAtlas;
 class WorkRequest;
 class Request;
 
@@ -29,12 +31,24 @@ public:
 
     bool reparse(std::function<void ()> callback);
 
+    // Parses the given bucket again the next time the tile is reparsed, e.g. because its layout
+    // changed. The other buckets are kept.
+    void invalidateBucket(const InternedString& name);
+
+    // Rebuilds the symbol buckets the next time the tile is reparsed, because the glyphs they
+    // refer to have moved in the GlyphAtlas.
+    void invalidateGlyphs();
+
     void redoPlacement(float angle, bool collisionDebug) override;
 
     void cancel() override;
 
+    // Identifies the glyphs this tile uses in the GlyphAtlas.
+    uintptr_t getGlyphAtlasUID() const { return reinterpret_cast<uintptr_t>(&tileWorker); }
+
 private:
     Worker& worker;
+    GlyphAtlas& glyphAtlas;
     TileWorker tileWorker;
     std::unique_ptr<WorkRequest> workRequest;
     bool parsing = false;
@@ -46,6 +60,10 @@ private:
     bool lastCollisionDebug = 0;
     bool currentCollisionDebug = 0;
     bool redoingPlacement = false;
+    std::unordered_set<InternedString> invalidatedBuckets;
+    bool glyphsInvalidated = false;
+    bool rebuildingGlyphs = false;
+    uint32_t glyphGeneration = 0;
 };
 
 }
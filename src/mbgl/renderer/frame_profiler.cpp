@@ -0,0 +1,416 @@
+#include <mbgl/renderer/frame_profiler.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+#ifndef GL_SAMPLES_PASSED
+#define GL_SAMPLES_PASSED 0x8914
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+namespace mbgl {
+
+static gl::ExtensionFunction<
+    void (GLsizei n, GLuint* ids)>
+    GenQueries({
+        {"GL_ARB_timer_query", "glGenQueries"},
+        {"GL_EXT_disjoint_timer_query", "glGenQueriesEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLsizei n, const GLuint* ids)>
+    DeleteQueries({
+        {"GL_ARB_timer_query", "glDeleteQueries"},
+        {"GL_EXT_disjoint_timer_query", "glDeleteQueriesEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLuint id, GLenum target)>
+    QueryCounter({
+        {"GL_ARB_timer_query", "glQueryCounter"},
+        {"GL_EXT_disjoint_timer_query", "glQueryCounterEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLuint id, GLenum pname, GLint* params)>
+    GetQueryObjectiv({
+        {"GL_ARB_timer_query", "glGetQueryObjectiv"},
+        {"GL_EXT_disjoint_timer_query", "glGetQueryObjectivEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLuint id, GLenum pname, uint64_t* params)>
+    GetQueryObjectui64v({
+        {"GL_ARB_timer_query", "glGetQueryObjectui64v"},
+        {"GL_EXT_disjoint_timer_query", "glGetQueryObjectui64vEXT"}
+    });
+
+static bool hasTimerQueries() {
+    return GenQueries && DeleteQueries && QueryCounter && GetQueryObjectiv && GetQueryObjectui64v;
+}
+
+// Returns whether timer queries that were in flight since the last call returned meaningless
+// results, e.g. because the GPU changed its clock frequency. Reading the flag resets it. Only
+// EXT_disjoint_timer_query on OpenGL ES reports this.
+static bool isGPUDisjoint() {
+#ifdef GL_ES_VERSION_2_0
+    GLint disjoint = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint));
+    return disjoint;
+#else
+    return false;
+#endif
+}
+
+// OpenGL ES only has boolean occlusion queries, which can't count fragments.
+static gl::ExtensionFunction<
+    void (GLsizei n, GLuint* ids)>
+    GenSamplesQueries({
+        {"GL_ARB_occlusion_query", "glGenQueriesARB"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLsizei n, const GLuint* ids)>
+    DeleteSamplesQueries({
+        {"GL_ARB_occlusion_query", "glDeleteQueriesARB"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLenum target, GLuint id)>
+    BeginSamplesQuery({
+        {"GL_ARB_occlusion_query", "glBeginQueryARB"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLenum target)>
+    EndSamplesQuery({
+        {"GL_ARB_occlusion_query", "glEndQueryARB"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLuint id, GLenum pname, GLuint* params)>
+    GetSamplesQueryObjectuiv({
+        {"GL_ARB_occlusion_query", "glGetQueryObjectuivARB"}
+    });
+
+static bool hasOcclusionQueries() {
+    return GenSamplesQueries && DeleteSamplesQueries && BeginSamplesQuery && EndSamplesQuery && GetSamplesQueryObjectuiv;
+}
+
+// Frames whose GPU timings haven't arrived after this many frames are reported without them.
+static const size_t maxPendingFrames = 4;
+
+FrameProfiler::Scope::Scope(FrameProfiler& profiler_, Kind kind_, const std::string& name)
+    : profiler(profiler_), kind(kind_) {
+    if (kind == Kind::Frame ? !profiler.enabled : !profiler.frameScope) {
+        return;
+    }
+
+    active = true;
+    profiler.getSection(kind, name, index);
+    query = profiler.queryTimestamp();
+    if (kind == Kind::Pass) {
+        samplesQuery = profiler.beginSamplesQuery();
+    }
+    start = Clock::now();
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (!active) {
+        return;
+    }
+
+    FrameSection& section = profiler.getSection(profiler.current.statistics, kind, index);
+    section.cpuTime += Clock::now() - start;
+
+    if (query) {
+        profiler.current.queries.push_back({ kind, index, query, profiler.queryTimestamp() });
+    }
+
+    if (samplesQuery) {
+        profiler.endSamplesQuery(index, samplesQuery);
+    }
+}
+
+FrameProfiler::~FrameProfiler() {
+    for (auto& frame : pending) {
+        for (auto& query : frame.queries) {
+            queryPool.push_back(query.begin);
+            queryPool.push_back(query.end);
+        }
+        for (auto& query : frame.samplesQueries) {
+            samplesQueryPool.push_back(query.query);
+        }
+    }
+
+    if (!queryPool.empty()) {
+        MBGL_CHECK_ERROR(DeleteQueries(static_cast<GLsizei>(queryPool.size()), queryPool.data()));
+    }
+
+    if (!samplesQueryPool.empty()) {
+        MBGL_CHECK_ERROR(DeleteSamplesQueries(static_cast<GLsizei>(samplesQueryPool.size()), samplesQueryPool.data()));
+    }
+}
+
+FrameSection& FrameProfiler::getSection(Kind kind, const std::string& name, size_t& index) {
+    FrameStatistics& stats = current.statistics;
+
+    switch (kind) {
+    case Kind::Frame:
+        index = 0;
+        stats.total.name = name;
+        return stats.total;
+    case Kind::Pass:
+        index = stats.passes.size();
+        stats.passes.emplace_back();
+        stats.passes.back().name = name;
+        return stats.passes.back();
+    case Kind::Layer:
+    default:
+        auto it = layerIndices.find(name);
+        if (it == layerIndices.end()) {
+            it = layerIndices.emplace(name, stats.layers.size()).first;
+            stats.layers.emplace_back();
+            stats.layers.back().name = name;
+        }
+        index = it->second;
+        return stats.layers[index];
+    }
+}
+
+FrameSection& FrameProfiler::getSection(FrameStatistics& stats, Kind kind, size_t index) {
+    switch (kind) {
+    case Kind::Frame: return stats.total;
+    case Kind::Pass: return stats.passes[index];
+    case Kind::Layer:
+    default: return stats.layers[index];
+    }
+}
+
+GLuint FrameProfiler::queryTimestamp() {
+    if (!hasTimerQueries()) {
+        return 0;
+    }
+
+    if (queryPool.empty()) {
+        queryPool.resize(32);
+        MBGL_CHECK_ERROR(GenQueries(static_cast<GLsizei>(queryPool.size()), queryPool.data()));
+    }
+
+    const GLuint query = queryPool.back();
+    queryPool.pop_back();
+    MBGL_CHECK_ERROR(QueryCounter(query, GL_TIMESTAMP));
+    return query;
+}
+
+GLuint FrameProfiler::beginSamplesQuery() {
+    if (!hasOcclusionQueries()) {
+        return 0;
+    }
+
+    if (samplesQueryPool.empty()) {
+        samplesQueryPool.resize(16);
+        MBGL_CHECK_ERROR(GenSamplesQueries(static_cast<GLsizei>(samplesQueryPool.size()), samplesQueryPool.data()));
+    }
+
+    const GLuint query = samplesQueryPool.back();
+    samplesQueryPool.pop_back();
+    MBGL_CHECK_ERROR(BeginSamplesQuery(GL_SAMPLES_PASSED, query));
+    return query;
+}
+
+void FrameProfiler::endSamplesQuery(size_t index, GLuint query) {
+    MBGL_CHECK_ERROR(EndSamplesQuery(GL_SAMPLES_PASSED));
+    current.samplesQueries.push_back({ index, query });
+}
+
+void FrameProfiler::beginFrame(uint64_t pixels) {
+    collect();
+
+    if (!enabled) {
+        return;
+    }
+
+    current = PendingFrame();
+    current.statistics.frame = ++frameCount;
+    current.statistics.pixels = pixels;
+    layerIndices.clear();
+
+    frameScope = std::make_unique<Scope>(*this, Kind::Frame, "frame");
+}
+
+void FrameProfiler::endFrame(uint64_t redundantGLCalls) {
+    const uint64_t redundant = redundantGLCalls - lastRedundantGLCalls;
+    lastRedundantGLCalls = redundantGLCalls;
+
+    if (!frameScope) {
+        return;
+    }
+
+    frameScope.reset();
+    current.statistics.redundantGLCalls = redundant;
+
+    if (current.queries.empty() && current.samplesQueries.empty()) {
+        finish(current, false);
+    } else {
+        pending.emplace_back(std::move(current));
+        if (pending.size() > maxPendingFrames) {
+            finish(pending.front(), false);
+            pending.pop_front();
+        }
+    }
+}
+
+void FrameProfiler::collect() {
+    size_t complete = 0;
+    for (; complete < pending.size(); ++complete) {
+        PendingFrame& frame = pending[complete];
+
+        // Queries complete in order, so the last one tells us whether all results are there.
+        if (!frame.queries.empty()) {
+            GLint available = 0;
+            MBGL_CHECK_ERROR(GetQueryObjectiv(frame.queries.back().end, GL_QUERY_RESULT_AVAILABLE, &available));
+            if (!available) {
+                break;
+            }
+        }
+        if (!frame.samplesQueries.empty()) {
+            GLuint available = 0;
+            MBGL_CHECK_ERROR(GetSamplesQueryObjectuiv(frame.samplesQueries.back().query, GL_QUERY_RESULT_AVAILABLE, &available));
+            if (!available) {
+                break;
+            }
+        }
+
+        for (const auto& query : frame.queries) {
+            uint64_t begin = 0, end = 0;
+            MBGL_CHECK_ERROR(GetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin));
+            MBGL_CHECK_ERROR(GetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end));
+
+            FrameSection& section = getSection(frame.statistics, query.kind, query.index);
+            section.gpuTime += std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(end - begin));
+        }
+
+        for (const auto& query : frame.samplesQueries) {
+            GLuint samples = 0;
+            MBGL_CHECK_ERROR(GetSamplesQueryObjectuiv(query.query, GL_QUERY_RESULT, &samples));
+            frame.statistics.passes[query.index].fragments += samples;
+        }
+    }
+
+    // The results have to be read before checking whether they're valid.
+    if (!pending.empty() && hasTimerQueries() && isGPUDisjoint()) {
+        for (auto& frame : pending) {
+            finish(frame, false);
+        }
+        pending.clear();
+        return;
+    }
+
+    for (; complete > 0; --complete) {
+        finish(pending.front(), true);
+        pending.pop_front();
+    }
+}
+
+void FrameProfiler::finish(PendingFrame& frame, bool withGPUTimes) {
+    for (const auto& query : frame.queries) {
+        FrameSection& section = getSection(frame.statistics, query.kind, query.index);
+        section.hasGPUTime = withGPUTimes;
+        if (!withGPUTimes) {
+            section.gpuTime = Duration::zero();
+        }
+        queryPool.push_back(query.begin);
+        queryPool.push_back(query.end);
+    }
+    frame.queries.clear();
+
+    for (const auto& query : frame.samplesQueries) {
+        FrameSection& section = frame.statistics.passes[query.index];
+        section.hasFragments = withGPUTimes;
+        if (!withGPUTimes) {
+            section.fragments = 0;
+        }
+        samplesQueryPool.push_back(query.query);
+    }
+    frame.samplesQueries.clear();
+
+    statistics = std::move(frame.statistics);
+}
+
+namespace {
+
+template <typename Writer>
+void writeSection(Writer& writer, const FrameSection& section) {
+    writer.StartObject();
+    writer.String("name");
+    writer.String(section.name.c_str(), rapidjson::SizeType(section.name.size()));
+    writer.String("cpu");
+    writer.Double(std::chrono::duration<double, std::milli>(section.cpuTime).count());
+    if (section.hasGPUTime) {
+        writer.String("gpu");
+        writer.Double(std::chrono::duration<double, std::milli>(section.gpuTime).count());
+    }
+    if (section.hasFragments) {
+        writer.String("fragments");
+        writer.Uint64(section.fragments);
+    }
+    writer.EndObject();
+}
+
+}
+
+double FrameStatistics::overdraw() const {
+    uint64_t fragments = 0;
+    for (const auto& pass : passes) {
+        if (pass.hasFragments) {
+            fragments += pass.fragments;
+        }
+    }
+    return pixels ? double(fragments) / pixels : 0;
+}
+
+std::string FrameStatistics::toJSON() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.String("frame");
+    writer.Uint64(frame);
+    writer.String("total");
+    writeSection(writer, total);
+    writer.String("redundantGLCalls");
+    writer.Uint64(redundantGLCalls);
+    writer.String("overdraw");
+    writer.Double(overdraw());
+
+    writer.String("passes");
+    writer.StartArray();
+    for (const auto& pass : passes) {
+        writeSection(writer, pass);
+    }
+    writer.EndArray();
+
+    writer.String("layers");
+    writer.StartArray();
+    for (const auto& layer : layers) {
+        writeSection(writer, layer);
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    return buffer.GetString();
+}
+
+}
@@ -0,0 +1,106 @@
+#ifndef MBGL_RENDERER_FRAME_PROFILER
+#define MBGL_RENDERER_FRAME_PROFILER
+
+#include <mbgl/map/frame_statistics.hpp>
+#include <mbgl/platform/gl.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+// Records CPU and GPU time per render pass and per style layer, and the number of fragments each
+// pass draws. GPU times use timestamp queries and fragments occlusion queries, whose results are
+// collected once they become available a few frames later, so getStatistics() always describes
+// the most recent frame whose results are complete.
+class FrameProfiler : private util::noncopyable {
+public:
+    enum class Kind : uint8_t {
+        Frame,
+        Pass,
+        Layer,
+    };
+
+    class Scope : private util::noncopyable {
+    public:
+        Scope(FrameProfiler&, Kind, const std::string& name);
+        ~Scope();
+
+    private:
+        FrameProfiler& profiler;
+        const Kind kind;
+        bool active = false;
+        size_t index = 0;
+        GLuint query = 0;
+        GLuint samplesQuery = 0;
+        TimePoint start;
+    };
+
+    ~FrameProfiler();
+
+    void setEnabled(bool enabled_) { enabled = enabled_; }
+    bool isEnabled() const { return enabled; }
+
+    // Everything between these two calls is attributed to the frame's total time.
+    void beginFrame(uint64_t pixels);
+    void endFrame(uint64_t redundantGLCalls);
+
+    // Statistics of the last frame whose GPU timings (if any) have been collected.
+    const FrameStatistics& getStatistics() const { return statistics; }
+
+private:
+    struct Query {
+        Kind kind;
+        size_t index;
+        GLuint begin;
+        GLuint end;
+    };
+
+    struct SamplesQuery {
+        size_t index;
+        GLuint query;
+    };
+
+    struct PendingFrame {
+        FrameStatistics statistics;
+        std::vector<Query> queries;
+        std::vector<SamplesQuery> samplesQueries;
+    };
+
+    FrameSection& getSection(Kind, const std::string& name, size_t& index);
+    FrameSection& getSection(FrameStatistics&, Kind, size_t index);
+
+    // Issues a timestamp query and returns it, or returns 0 if timer queries aren't supported.
+    GLuint queryTimestamp();
+
+    // Starts counting the samples that pass and returns the query, or returns 0 if occlusion
+    // queries aren't supported. Only one can be active at a time.
+    GLuint beginSamplesQuery();
+    void endSamplesQuery(size_t index, GLuint query);
+
+    // Moves all frames whose queries have finished into `statistics`.
+    void collect();
+    void finish(PendingFrame&, bool withGPUTimes);
+
+    bool enabled = false;
+    std::unique_ptr<Scope> frameScope;
+    uint64_t frameCount = 0;
+    uint64_t lastRedundantGLCalls = 0;
+
+    PendingFrame current;
+    std::unordered_map<std::string, size_t> layerIndices;
+
+    std::deque<PendingFrame> pending;
+    std::vector<GLuint> queryPool;
+    std::vector<GLuint> samplesQueryPool;
+
+    FrameStatistics statistics;
+};
+
+}
+
+#endif
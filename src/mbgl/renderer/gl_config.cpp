@@ -1,5 +1,8 @@
 #include "gl_config.hpp"
 
+#include <mbgl/geometry/vao.hpp>
+#include <mbgl/util/thread_context.hpp>
+
 namespace mbgl {
 namespace gl {
 
@@ -14,6 +17,85 @@ const StencilTest::Type StencilTest::Default = false;
 const DepthRange::Type DepthRange::Default = { 0, 1 };
 const DepthTest::Type DepthTest::Default = false;
 const Blend::Type Blend::Default = false;
+const Program::Type Program::Default = 0;
+const ActiveTexture::Type ActiveTexture::Default = GL_TEXTURE0;
+const BindTexture::Type BindTexture::Default = 0;
+const BindVertexArray::Type BindVertexArray::Default = 0;
+
+void BindVertexArray::Set(const Type& value) {
+    VertexArrayObject::Bind(value);
+}
+
+void Config::resetBindings() {
+    program.reset();
+    activeTexture.reset();
+    texture.reset();
+    arrayBuffer.reset();
+    elementArrayBuffer.reset();
+    vertexArray.reset();
+}
+
+size_t Config::getRedundantCalls() const {
+    return stencilFunc.getRedundantCalls() +
+           stencilMask.getRedundantCalls() +
+           stencilTest.getRedundantCalls() +
+           depthRange.getRedundantCalls() +
+           depthMask.getRedundantCalls() +
+           depthTest.getRedundantCalls() +
+           blend.getRedundantCalls() +
+           colorMask.getRedundantCalls() +
+           clearDepth.getRedundantCalls() +
+           clearColor.getRedundantCalls() +
+           clearStencil.getRedundantCalls() +
+           program.getRedundantCalls() +
+           activeTexture.getRedundantCalls() +
+           texture.getRedundantCalls() +
+           arrayBuffer.getRedundantCalls() +
+           elementArrayBuffer.getRedundantCalls() +
+           vertexArray.getRedundantCalls();
+}
+
+void activeTexture(GLenum texture) {
+    if (Config* config = util::ThreadContext::getGLConfig()) {
+        if (!config->activeTexture.isCurrent(texture)) {
+            // We only track the binding of the active texture unit.
+            config->texture.reset();
+        }
+        config->activeTexture = texture;
+    } else {
+        ActiveTexture::Set(texture);
+    }
+}
+
+void bindTexture(GLuint texture) {
+    if (Config* config = util::ThreadContext::getGLConfig()) {
+        config->texture = texture;
+    } else {
+        BindTexture::Set(texture);
+    }
+}
+
+void bindBuffer(GLenum target, GLuint buffer) {
+    Config* config = util::ThreadContext::getGLConfig();
+    if (config && target == GL_ARRAY_BUFFER) {
+        config->arrayBuffer = buffer;
+    } else if (config && target == GL_ELEMENT_ARRAY_BUFFER) {
+        config->elementArrayBuffer = buffer;
+    } else {
+        MBGL_CHECK_ERROR(glBindBuffer(target, buffer));
+    }
+}
+
+void bindVertexArray(GLuint array) {
+    if (Config* config = util::ThreadContext::getGLConfig()) {
+        if (!config->vertexArray.isCurrent(array)) {
+            config->elementArrayBuffer.reset();
+        }
+        config->vertexArray = array;
+    } else {
+        BindVertexArray::Set(array);
+    }
+}
 
 }
 }
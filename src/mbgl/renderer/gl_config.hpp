@@ -14,14 +14,33 @@ template <typename T>
 class Value {
 public:
     inline void operator=(const typename T::Type& value) {
-        if (current != value) {
+        if (dirty || current != value) {
+            dirty = false;
             current = value;
             MBGL_CHECK_ERROR(T::Set(current));
+        } else {
+            redundant++;
         }
     }
 
+    inline bool isCurrent(const typename T::Type& value) const {
+        return !dirty && !(current != value);
+    }
+
+    // Forgets the cached value so that the next assignment is passed on to OpenGL.
+    inline void reset() {
+        dirty = true;
+    }
+
+    // Number of assignments that were skipped because the value was already set.
+    inline size_t getRedundantCalls() const {
+        return redundant;
+    }
+
 private:
     typename T::Type current = T::Default;
+    bool dirty = false;
+    size_t redundant = 0;
 };
 
 struct ClearDepth {
@@ -128,6 +147,45 @@ struct Blend {
     }
 };
 
+struct Program {
+    using Type = GLuint;
+    static const Type Default;
+    inline static void Set(const Type& value) {
+        MBGL_CHECK_ERROR(glUseProgram(value));
+    }
+};
+
+struct ActiveTexture {
+    using Type = GLenum;
+    static const Type Default;
+    inline static void Set(const Type& value) {
+        MBGL_CHECK_ERROR(glActiveTexture(value));
+    }
+};
+
+struct BindTexture {
+    using Type = GLuint;
+    static const Type Default;
+    inline static void Set(const Type& value) {
+        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, value));
+    }
+};
+
+template <GLenum target>
+struct BindBuffer {
+    using Type = GLuint;
+    static const Type Default = 0;
+    inline static void Set(const Type& value) {
+        MBGL_CHECK_ERROR(glBindBuffer(target, value));
+    }
+};
+
+struct BindVertexArray {
+    using Type = GLuint;
+    static const Type Default;
+    static void Set(const Type& value);
+};
+
 class Config {
 public:
     Value<StencilFunc> stencilFunc;
@@ -141,8 +199,30 @@ public:
     Value<ClearDepth> clearDepth;
     Value<ClearColor> clearColor;
     Value<ClearStencil> clearStencil;
+
+    // Object bindings. The element array buffer binding is part of the vertex array object state.
+    Value<Program> program;
+    Value<ActiveTexture> activeTexture;
+    Value<BindTexture> texture;
+    Value<BindBuffer<GL_ARRAY_BUFFER>> arrayBuffer;
+    Value<BindBuffer<GL_ELEMENT_ARRAY_BUFFER>> elementArrayBuffer;
+    Value<BindVertexArray> vertexArray;
+
+    // Marks all object bindings as unknown. Call this after objects were deleted, or when
+    // code outside of our control may have changed the bindings.
+    void resetBindings();
+
+    // Total number of GL calls that were skipped because the state was already set.
+    size_t getRedundantCalls() const;
 };
 
+// These functions change object bindings through the current thread's Config if there is one,
+// and call OpenGL directly otherwise.
+void activeTexture(GLenum texture);
+void bindTexture(GLuint texture);
+void bindBuffer(GLenum target, GLuint buffer);
+void bindVertexArray(GLuint array);
+
 }
 }
 
@@ -414,7 +414,7 @@ void LineBucket::drawLines(LineShader& shader) {
         }
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
-                                        elements_index));
+                                        elements_index + triangleElementsBuffer.getOffset()));
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -430,7 +430,7 @@ void LineBucket::drawLineSDF(LineSDFShader& shader) {
         }
         group->array[2].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
-                                        elements_index));
+                                        elements_index + triangleElementsBuffer.getOffset()));
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -446,7 +446,7 @@ void LineBucket::drawLinePatterns(LinepatternShader& shader) {
         }
         group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
-                                        elements_index));
+                                        elements_index + triangleElementsBuffer.getOffset()));
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -11,6 +11,7 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/style/style_bucket.hpp>
+#include <mbgl/renderer/symbol_bucket.hpp>
 
 #include <mbgl/geometry/sprite_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
@@ -31,6 +32,7 @@
 
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mat3.hpp>
+#include <mbgl/util/thread_context.hpp>
 
 #if defined(DEBUG)
 #include <mbgl/util/stopwatch.hpp>
@@ -43,13 +45,15 @@
 using namespace mbgl;
 
 Painter::Painter(MapData& data_) : data(data_) {
+    util::ThreadContext::setGLConfig(&config);
 }
 
 Painter::~Painter() {
+    util::ThreadContext::setGLConfig(nullptr);
 }
 
 bool Painter::needsAnimation() const {
-    return frameHistory.needsAnimation(data.getDefaultFadeDuration());
+    return frameHistory.needsAnimation(data.getDefaultFadeDuration()) || symbolPlacement.needsAnimation();
 }
 
 void Painter::setup() {
@@ -118,10 +122,7 @@ void Painter::setDebug(bool enabled) {
 }
 
 void Painter::useProgram(uint32_t program) {
-    if (gl_program != program) {
-        MBGL_CHECK_ERROR(glUseProgram(program));
-        gl_program = program;
-    }
+    config.program = program;
 }
 
 void Painter::lineWidth(float line_width) {
@@ -170,6 +171,12 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     state = state_;
     frame = frame_;
 
+    // Other code sharing the context may have changed the bindings since the last frame.
+    config.resetBindings();
+
+    profiler.setEnabled(data.getFrameProfiling());
+    profiler.beginFrame(uint64_t(frame.framebufferSize[0]) * frame.framebufferSize[1]);
+
     glyphAtlas = style.glyphAtlas.get();
     spriteAtlas = style.spriteAtlas.get();
     lineAtlas = style.lineAtlas.get();
@@ -185,12 +192,13 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     changeMatrix();
 
     // Figure out what buckets we have to draw and what order we have to draw them in.
-    const auto order = determineRenderOrder(style);
+    const auto& order = determineRenderOrder(style);
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
     {
         const gl::debugging::group upload("upload");
+        const FrameProfiler::Scope profile(profiler, FrameProfiler::Kind::Pass, "upload");
 
         tileStencilBuffer.upload();
         tileBorderBuffer.upload();
@@ -210,6 +218,7 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     // Draws the clipping masks to the stencil buffer.
     {
         const gl::debugging::group clip("clip");
+        const FrameProfiler::Scope profile(profiler, FrameProfiler::Kind::Pass, "clip");
 
         // Update all clipping IDs.
         ClipIDGenerator generator;
@@ -225,11 +234,35 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
 
     frameHistory.record(time, state.getNormalizedZoom());
 
+    // - SYMBOL PLACEMENT --------------------------------------------------------------------------
+    // Resolves collisions between symbols of different tiles. Runs after the clip pass so that
+    // the tile matrices are up to date.
+    {
+        const FrameProfiler::Scope profile(profiler, FrameProfiler::Kind::Pass, "placement");
+
+        symbolPlacement.beginFrame(state, time, data.getDefaultFadeDuration());
+        for (const auto& item : order) {
+            if (item.bucket && item.tile && item.layer.type == StyleLayerType::Symbol) {
+                symbolPlacement.place(static_cast<SymbolBucket&>(*item.bucket), item.tile->matrix);
+            }
+        }
+    }
+
     // Actually render the layers
     if (debug::renderTree) { Log::Info(Event::Render, "{"); indent++; }
 
-    // TODO: Correctly compute the number of layers recursively beforehand.
-    const float strataThickness = 1.0f / (order.size() + 1);
+    // All tiles of a layer share one stratum; the stencil clipping masks already guarantee that
+    // they don't overlap each other.
+    std::size_t layerCount = 0;
+    const StyleLayer* previousLayer = nullptr;
+    for (const auto& item : order) {
+        if (&item.layer != previousLayer) {
+            previousLayer = &item.layer;
+            layerCount++;
+        }
+    }
+
+    const float strataThickness = 1.0f / (layerCount + 1);
 
     // - OPAQUE PASS -------------------------------------------------------------------------------
     // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
@@ -241,7 +274,7 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
     renderPass(RenderPass::Translucent,
                order.begin(), order.end(),
-               order.size() - 1, -1, strataThickness);
+               layerCount - 1, -1, strataThickness);
 
     if (debug::renderTree) { Log::Info(Event::Render, "}"); indent--; }
 
@@ -249,6 +282,7 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     // Renders debug overlays.
     {
         const gl::debugging::group _("debug");
+        const FrameProfiler::Scope profile(profiler, FrameProfiler::Kind::Pass, "debug");
 
         // Finalize the rendering, e.g. by calling debug render calls per tile.
         // This guarantees that we have at least one function per tile called.
@@ -264,9 +298,11 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     {
         const gl::debugging::group _("cleanup");
 
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, 0));
+        config.texture = 0;
         MBGL_CHECK_ERROR(VertexArrayObject::Unbind());
     }
+
+    profiler.endFrame(config.getRedundantCalls());
 }
 
 template <class Iterator>
@@ -278,6 +314,7 @@ void Painter::renderPass(RenderPass pass_,
 
     const char * passName = pass == RenderPass::Opaque ? "opaque" : "translucent";
     const gl::debugging::group _(passName);
+    const FrameProfiler::Scope profile(profiler, FrameProfiler::Kind::Pass, passName);
 
     if (debug::renderTree) {
         Log::Info(Event::Render, "%*s%s {", indent++ * 4, "", passName);
@@ -285,19 +322,42 @@ void Painter::renderPass(RenderPass pass_,
 
     config.blend = pass == RenderPass::Translucent;
 
-    for (; it != end; ++it, i += increment) {
-        const auto& item = *it;
-        if (item.bucket && item.tile) {
-            if (item.hasRenderPass(pass)) {
-                const gl::debugging::group group(item.layer.id + " - " + std::string(item.tile->id));
-                setStrata(i * strataThickness);
+    // The stratum and debug group are set up once for each run of consecutive items of the same
+    // layer; between its tiles, only the stencil state and the matrix change. Draws are not
+    // batched: each tile is still drawn on its own because it needs its own stencil reference
+    // value to be clipped correctly.
+    for (; it != end; i += increment) {
+        const StyleLayer& layer = it->layer;
+
+        if (!it->bucket || !it->tile) {
+            const gl::debugging::group group("background");
+            const FrameProfiler::Scope profileLayer(profiler, FrameProfiler::Kind::Layer, layer.id);
+            setStrata(i * strataThickness);
+            renderBackground(layer);
+            ++it;
+            continue;
+        }
+
+        // Skip runs that have nothing to draw in this pass.
+        bool hasPass = false;
+        Iterator runEnd = it;
+        for (; runEnd != end && &runEnd->layer == &layer; ++runEnd) {
+            hasPass = hasPass || (runEnd->bucket && runEnd->tile && runEnd->hasRenderPass(pass));
+        }
+        if (!hasPass) {
+            it = runEnd;
+            continue;
+        }
+
+        const gl::debugging::group group(layer.id);
+        const FrameProfiler::Scope profileLayer(profiler, FrameProfiler::Kind::Layer, layer.id);
+        setStrata(i * strataThickness);
+        for (; it != runEnd; ++it) {
+            const auto& item = *it;
+            if (item.bucket && item.tile && item.hasRenderPass(pass)) {
                 prepareTile(*item.tile);
                 item.bucket->render(*this, item.layer, item.tile->id, item.tile->matrix);
             }
-        } else {
-            const gl::debugging::group group("background");
-            setStrata(i * strataThickness);
-            renderBackground(item.layer);
         }
     }
 
@@ -306,15 +366,16 @@ void Painter::renderPass(RenderPass pass_,
     }
 }
 
-std::vector<RenderItem> Painter::determineRenderOrder(const Style& style) {
-    std::vector<RenderItem> order;
+const std::vector<RenderItem>& Painter::determineRenderOrder(const Style& style) {
+    // Finding out which layers are drawn is cheap; looking up their buckets in every tile isn't.
+    nextRenderLayers.clear();
 
     for (const auto& layerPtr : style.layers) {
         const auto& layer = *layerPtr;
         if (layer.bucket->visibility == VisibilityType::None) continue;
         if (layer.type == StyleLayerType::Background) {
             // This layer defines a background color/image.
-            order.emplace_back(layer);
+            nextRenderLayers.push_back({ &layer, nullptr, 0, RenderPass::Opaque });
             continue;
         }
 
@@ -347,7 +408,29 @@ std::vector<RenderItem> Painter::determineRenderOrder(const Style& style) {
         // Determine what render passes we need for this layer.
         const RenderPass passes = determineRenderPasses(layer);
 
-        const auto& tiles = source->getTiles();
+        nextRenderLayers.push_back({ &layer, source, source->getGeneration(), passes });
+    }
+
+    if (nextRenderLayers != renderLayers) {
+        std::swap(renderLayers, nextRenderLayers);
+        renderOrderStyleLayers = style.layers;
+        buildRenderOrder();
+    }
+
+    return renderOrder;
+}
+
+void Painter::buildRenderOrder() {
+    renderOrder.clear();
+
+    for (const auto& renderLayer : renderLayers) {
+        const StyleLayer& layer = *renderLayer.layer;
+        if (!renderLayer.source) {
+            renderOrder.emplace_back(layer);
+            continue;
+        }
+
+        const auto& tiles = renderLayer.source->getTiles();
         for (auto tile : tiles) {
             assert(tile);
             if (!tile->data && !tile->data->isReady()) {
@@ -356,12 +439,10 @@ std::vector<RenderItem> Painter::determineRenderOrder(const Style& style) {
 
             auto bucket = tile->data->getBucket(layer);
             if (bucket) {
-                order.emplace_back(layer, tile, bucket, passes);
+                renderOrder.emplace_back(layer, tile, bucket, renderLayer.passes);
             }
         }
     }
-
-    return order;
 }
 
 RenderPass Painter::determineRenderPasses(const StyleLayer& layer) {
@@ -441,8 +522,7 @@ void Painter::renderBackground(const StyleLayer &layer_desc) {
         patternShader->u_patternmatrix_a = matrixA;
         patternShader->u_patternmatrix_b = matrixB;
 
-        backgroundBuffer.bind();
-        patternShader->bind(0);
+        backgroundPatternArray.bind(*patternShader, backgroundBuffer, BUFFER_OFFSET(0));
         spriteAtlas->bind(true);
     } else {
         Color color = properties.color;
@@ -5,6 +5,7 @@
 #include <mbgl/map/map_context.hpp>
 
 #include <mbgl/renderer/frame_history.hpp>
+#include <mbgl/renderer/frame_profiler.hpp>
 #include <mbgl/renderer/bucket.hpp>
 
 #include <mbgl/geometry/vao.hpp>
@@ -12,14 +13,18 @@
 
 #include <mbgl/renderer/gl_config.hpp>
 
+#include <mbgl/text/cross_tile_placement.hpp>
+
 #include <mbgl/style/types.hpp>
 
 #include <mbgl/platform/gl.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/ptr.hpp>
 
 #include <array>
+#include <functional>
 #include <vector>
 #include <set>
 
@@ -141,11 +146,17 @@ public:
 
     bool needsAnimation() const;
 
+    // Timings of the last fully profiled frame; empty unless frame profiling is enabled.
+    const FrameStatistics& getFrameStatistics() const { return profiler.getStatistics(); }
+
 private:
     void setupShaders();
     mat4 translatedMatrix(const mat4& matrix, const std::array<float, 2> &translation, const TileID &id, TranslateAnchorType anchor);
 
-    std::vector<RenderItem> determineRenderOrder(const Style& style);
+    // Returns the cached render order, and rebuilds it first if the layers that are drawn, their
+    // render passes or the tiles of their sources changed since the last frame.
+    const std::vector<RenderItem>& determineRenderOrder(const Style& style);
+    void buildRenderOrder();
     static RenderPass determineRenderPasses(const StyleLayer&);
 
     template <class Iterator>
@@ -165,7 +176,7 @@ private:
                    float scaleDivisor,
                    std::array<float, 2> texsize,
                    SDFShader& sdfShader,
-                   void (SymbolBucket::*drawSDF)(SDFShader&));
+                   void (SymbolBucket::*drawSDF)(SDFShader&, const std::function<void (float)>&));
 
 public:
     void useProgram(uint32_t program);
@@ -200,14 +211,36 @@ private:
     int indent = 0;
 
     gl::Config config;
+    FrameProfiler profiler;
+    CrossTilePlacement symbolPlacement;
 
-    uint32_t gl_program = 0;
     float gl_lineWidth = 0;
     std::array<uint16_t, 2> gl_viewport = {{ 0, 0 }};
     float strata = 0;
     RenderPass pass = RenderPass::Opaque;
     const float strata_epsilon = 1.0f / (1 << 16);
 
+    // A layer that is drawn in the current frame. Background layers don't have a source.
+    struct RenderLayer {
+        const StyleLayer* layer;
+        Source* source;
+        uint64_t sourceGeneration;
+        RenderPass passes;
+
+        bool operator==(const RenderLayer& other) const {
+            return layer == other.layer && source == other.source &&
+                   sourceGeneration == other.sourceGeneration && passes == other.passes;
+        }
+    };
+
+    std::vector<RenderLayer> renderLayers;
+    std::vector<RenderLayer> nextRenderLayers;
+    std::vector<RenderItem> renderOrder;
+
+    // Keeps the layers of the cached render order alive, so that a layer of a new style can't
+    // take the address of one that it refers to.
+    std::vector<util::ptr<StyleLayer>> renderOrderStyleLayers;
+
 public:
     FrameHistory frameHistory;
 
@@ -235,6 +268,7 @@ public:
     };
 
     VertexArrayObject backgroundArray;
+    VertexArrayObject backgroundPatternArray;
 
     // Set up the stencil quad we're using to generate the stencil mask.
     StaticVertexBuffer tileStencilBuffer = {
@@ -90,7 +90,7 @@ void Painter::renderFill(FillBucket& bucket, const StyleLayer &layer_desc, const
             patternShader->u_patternmatrix_a = patternMatrixA;
             patternShader->u_patternmatrix_b = patternMatrixB;
 
-            MBGL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0));
+            gl::activeTexture(GL_TEXTURE0);
             spriteAtlas->bind(true);
 
             // Draw the actual triangles into the color & stencil buffer.
@@ -109,7 +109,7 @@ void Painter::renderLine(LineBucket& bucket, const StyleLayer &layer_desc, const
         linepatternShader->u_fade = properties.image.t;
         linepatternShader->u_opacity = properties.opacity;
 
-        MBGL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0));
+        gl::activeTexture(GL_TEXTURE0);
         spriteAtlas->bind(true);
         config.depthRange = { strata + strata_epsilon, 1.0f };  // may or may not matter
 
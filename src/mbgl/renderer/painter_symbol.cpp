@@ -24,7 +24,7 @@ void Painter::renderSDF(SymbolBucket &bucket,
                         float sdfFontSize,
                         std::array<float, 2> texsize,
                         SDFShader& sdfShader,
-                        void (SymbolBucket::*drawSDF)(SDFShader&))
+                        void (SymbolBucket::*drawSDF)(SDFShader&, const SymbolBucket::OpacitySetter&))
 {
     mat4 vtxMatrix = translatedMatrix(matrix, styleProperties.translate, id, styleProperties.translate_anchor);
 
@@ -67,47 +67,40 @@ void Painter::renderSDF(SymbolBucket &bucket,
     const float blurOffset = 1.19f;
     const float haloOffset = 6.0f;
 
+    // Symbols fading in or out after cross-tile placement are drawn with a reduced opacity.
+    const auto setColor = [&](const Color& baseColor) {
+        return [&sdfShader, &styleProperties, baseColor](float symbolOpacity) {
+            const float opacity = styleProperties.opacity * symbolOpacity;
+            if (opacity < 1.0f) {
+                Color color = baseColor;
+                color[0] *= opacity;
+                color[1] *= opacity;
+                color[2] *= opacity;
+                color[3] *= opacity;
+                sdfShader.u_color = color;
+            } else {
+                sdfShader.u_color = baseColor;
+            }
+        };
+    };
+
     // We're drawing in the translucent pass which is bottom-to-top, so we need
     // to draw the halo first.
     if (styleProperties.halo_color[3] > 0.0f) {
         sdfShader.u_gamma = styleProperties.halo_blur * blurOffset / fontScale / sdfPx + gamma;
-
-        if (styleProperties.opacity < 1.0f) {
-            Color color = styleProperties.halo_color;
-            color[0] *= styleProperties.opacity;
-            color[1] *= styleProperties.opacity;
-            color[2] *= styleProperties.opacity;
-            color[3] *= styleProperties.opacity;
-            sdfShader.u_color = color;
-        } else {
-            sdfShader.u_color = styleProperties.halo_color;
-        }
-
         sdfShader.u_buffer = (haloOffset - styleProperties.halo_width / fontScale) / sdfPx;
 
         config.depthRange = { strata, 1.0f };
-        (bucket.*drawSDF)(sdfShader);
+        (bucket.*drawSDF)(sdfShader, setColor(styleProperties.halo_color));
     }
 
     // Then, we draw the text/icon over the halo
     if (styleProperties.color[3] > 0.0f) {
         sdfShader.u_gamma = gamma;
-
-        if (styleProperties.opacity < 1.0f) {
-            Color color = styleProperties.color;
-            color[0] *= styleProperties.opacity;
-            color[1] *= styleProperties.opacity;
-            color[2] *= styleProperties.opacity;
-            color[3] *= styleProperties.opacity;
-            sdfShader.u_color = color;
-        } else {
-            sdfShader.u_color = styleProperties.color;
-        }
-
         sdfShader.u_buffer = (256.0f - 64.0f) / 256.0f;
 
         config.depthRange = { strata + strata_epsilon, 1.0f };
-        (bucket.*drawSDF)(sdfShader);
+        (bucket.*drawSDF)(sdfShader, setColor(styleProperties.color));
     }
 }
 
@@ -198,15 +191,15 @@ void Painter::renderSymbol(SymbolBucket &bucket, const StyleLayer &layer_desc, c
             iconShader->u_minfadezoom = state.getNormalizedZoom() * 10;
             iconShader->u_maxfadezoom = state.getNormalizedZoom() * 10;
             iconShader->u_fadezoom = state.getNormalizedZoom() * 10;
-            iconShader->u_opacity = properties.icon.opacity;
-
             config.depthRange = { strata, 1.0f };
-            bucket.drawIcons(*iconShader);
+            bucket.drawIcons(*iconShader, [&](float opacity) {
+                iconShader->u_opacity = properties.icon.opacity * opacity;
+            });
         }
     }
 
     if (bucket.hasTextData()) {
-        glyphAtlas->bind();
+        glyphAtlas->bind(bucket.getGlyphAtlasUID(), bucket.getGlyphGeneration());
 
         renderSDF(bucket,
                   id,
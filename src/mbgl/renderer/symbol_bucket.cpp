@@ -89,20 +89,14 @@ bool SymbolBucket::hasIconData() const { return renderData && !renderData->icon.
 
 bool SymbolBucket::hasCollisionBoxData() const { return renderData && !renderData->collisionBox.groups.empty(); }
 
-bool SymbolBucket::needsDependencies(const GeometryTileLayer& layer,
-                                     const FilterExpression& filter,
-                                     GlyphStore& glyphStore,
-                                     Sprite& sprite) {
+void SymbolBucket::parseFeatures(const GeometryTileLayer& layer, const FilterExpression& filter) {
     const bool has_text = !layout.text.field.empty() && !layout.text.font.empty();
     const bool has_icon = !layout.icon.image.empty();
 
     if (!has_text && !has_icon) {
-        return false;
+        return;
     }
 
-    // Determine and load glyph ranges
-    std::set<GlyphRange> ranges;
-
     for (std::size_t i = 0; i < layer.featureCount(); i++) {
         auto feature = layer.getFeature(i);
 
@@ -159,7 +153,17 @@ bool SymbolBucket::needsDependencies(const GeometryTileLayer& layer,
     if (layout.placement == PlacementType::Line) {
         util::mergeLines(features);
     }
+}
 
+bool SymbolBucket::needsDependencies(GlyphStore& glyphStore, Sprite& sprite) {
+    const bool has_text = !layout.text.field.empty() && !layout.text.font.empty();
+    const bool has_icon = !layout.icon.image.empty();
+
+    if (!has_text && !has_icon) {
+        return false;
+    }
+
+    // Determine and load glyph ranges
     if (!glyphStore.hasGlyphRanges(layout.text.font, ranges)) {
         return true;
     }
@@ -218,6 +222,10 @@ void SymbolBucket::addFeatures(uintptr_t tileUID,
 
     auto fontStack = glyphStore.getFontStack(layout.text.font);
 
+    // If the atlas is compacted while the features are added, the tile is rebuilt anyway.
+    glyphAtlasUID = tileUID;
+    glyphGeneration = glyphAtlas.getGeneration();
+
     for (const auto& feature : features) {
         if (feature.geometry.empty()) continue;
 
@@ -263,6 +271,7 @@ void SymbolBucket::addFeatures(uintptr_t tileUID,
     }
 
     features.clear();
+    ranges.clear();
 
     placeFeatures(true);
 }
@@ -359,8 +368,6 @@ void SymbolBucket::placeFeatures() {
 
 void SymbolBucket::placeFeatures(bool swapImmediately) {
 
-    renderDataInProgress = std::make_unique<SymbolRenderData>();
-
     // Calculate which labels can be shown and when they can be shown and
     // create the bufers used for rendering.
 
@@ -378,17 +385,27 @@ void SymbolBucket::placeFeatures(bool swapImmediately) {
     // are drawn on top of higher symbols.
     // Don't sort symbols that won't overlap because it isn't necessary and
     // because it causes more labels to pop in and out when rotating.
+    bool orderChanged = false;
     if (mayOverlap) {
         float sin = std::sin(collision.angle);
         float cos = std::cos(collision.angle);
 
-        std::sort(symbolInstances.begin(), symbolInstances.end(), [sin, cos](SymbolInstance &a, SymbolInstance &b) {
+        const auto compare = [sin, cos](const SymbolInstance &a, const SymbolInstance &b) {
             const float aRotated = sin * a.x + cos * a.y;
             const float bRotated = sin * b.x + cos * b.y;
             return aRotated < bRotated;
-        });
+        };
+
+        if (!std::is_sorted(symbolInstances.begin(), symbolInstances.end(), compare)) {
+            std::sort(symbolInstances.begin(), symbolInstances.end(), compare);
+            orderChanged = true;
+        }
     }
 
+    auto placement = std::make_unique<Placement>();
+    placement->scales.reserve(symbolInstances.size() * 2);
+    placement->debug = collision.getDebug();
+
     for (SymbolInstance &symbolInstance : symbolInstances) {
 
         const bool hasText = symbolInstance.hasText;
@@ -416,36 +433,89 @@ void SymbolBucket::placeFeatures(bool swapImmediately) {
         }
 
 
-        // Insert final placement into collision tree and add glyphs/icons to buffers
+        // Insert final placement into collision tree
+
+        if (hasText && !layout.text.ignore_placement) {
+            collision.insertFeature(symbolInstance.textCollisionFeature, glyphScale);
+        }
+
+        if (hasIcon && !layout.icon.ignore_placement) {
+            collision.insertFeature(symbolInstance.iconCollisionFeature, iconScale);
+        }
 
-        if (hasText) {
-            if (!layout.text.ignore_placement) {
-                collision.insertFeature(symbolInstance.textCollisionFeature, glyphScale);
+        placement->scales.push_back(glyphScale);
+        placement->scales.push_back(iconScale);
+
+        if (hasText && glyphScale < collision.maxScale && layout.text.keep_upright && textAlongLine) {
+            for (const auto& symbol : symbolInstance.glyphQuads) {
+                placement->upsideDown.push_back(isUpsideDown(symbol));
             }
-            if (glyphScale < collision.maxScale) {
-                addSymbols<SymbolRenderData::TextBuffer, TextElementGroup>(renderDataInProgress->text,
-                        symbolInstance.glyphQuads, glyphScale, layout.text.keep_upright, textAlongLine);
+        }
+
+        if (hasIcon && iconScale < collision.maxScale && layout.icon.keep_upright && iconAlongLine) {
+            for (const auto& symbol : symbolInstance.iconQuads) {
+                placement->upsideDown.push_back(isUpsideDown(symbol));
             }
         }
+    }
 
-        if (hasIcon) {
-            if (!layout.icon.ignore_placement) {
-                collision.insertFeature(symbolInstance.iconCollisionFeature, iconScale);
+    // Small rotations usually don't change which symbols are shown or at which scale, and the
+    // buffers don't depend on the angle otherwise, so the existing ones can be kept. Debug
+    // boxes are drawn rotated and always need to be rebuilt.
+    if (lastPlacement && !orderChanged && !placement->debug && !lastPlacement->debug &&
+        placement->scales == lastPlacement->scales && placement->upsideDown == lastPlacement->upsideDown) {
+        return;
+    }
+
+    renderDataInProgress = std::make_unique<SymbolRenderData>();
+
+    // Add glyphs/icons to buffers
+
+    for (std::size_t i = 0; i < symbolInstances.size(); i++) {
+        const SymbolInstance &symbolInstance = symbolInstances[i];
+        const float glyphScale = placement->scales[i * 2];
+        const float iconScale = placement->scales[i * 2 + 1];
+
+        PlacedSymbol placed;
+
+        if (symbolInstance.hasText && glyphScale < collision.maxScale) {
+            placed.text = addSymbols<SymbolRenderData::TextBuffer, TextElementGroup>(renderDataInProgress->text,
+                    symbolInstance.glyphQuads, glyphScale, layout.text.keep_upright, textAlongLine);
+        }
+
+        if (symbolInstance.hasIcon && iconScale < collision.maxScale) {
+            placed.icon = addSymbols<SymbolRenderData::IconBuffer, IconElementGroup>(renderDataInProgress->icon,
+                    symbolInstance.iconQuads, iconScale, layout.icon.keep_upright, iconAlongLine);
+        }
+
+        if (placed.text.count || placed.icon.count) {
+            if (placed.text.count) {
+                placed.textBoxes = symbolInstance.textCollisionFeature.boxes;
+                placed.textScale = glyphScale;
             }
-            if (iconScale < collision.maxScale) {
-                addSymbols<SymbolRenderData::IconBuffer, IconElementGroup>(renderDataInProgress->icon,
-                        symbolInstance.iconQuads, iconScale, layout.icon.keep_upright, iconAlongLine);
+            if (placed.icon.count) {
+                placed.iconBoxes = symbolInstance.iconCollisionFeature.boxes;
+                placed.iconScale = iconScale;
             }
+            renderDataInProgress->symbols.push_back(std::move(placed));
         }
     }
 
-    if (collision.getDebug()) addToDebugBuffers();
+    if (placement->debug) addToDebugBuffers();
+
+    lastPlacement = std::move(placement);
 
     if (swapImmediately) swapRenderData();
 }
 
+bool SymbolBucket::isUpsideDown(const SymbolQuad &symbol) const {
+    const float a = std::fmod(symbol.angle + collision.angle + M_PI, M_PI * 2);
+    return a <= M_PI / 2 || a > M_PI * 3 / 2;
+}
+
 template <typename Buffer, typename GroupType>
-void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float scale, const bool keepUpright, const bool alongLine) {
+PlacedSymbol::Range SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float scale, const bool keepUpright, const bool alongLine) {
+    PlacedSymbol::Range range;
     const float zoom = collision.zoom;
 
     const float placementZoom = std::fmax(std::log(scale) / std::log(2) + zoom, 0);
@@ -463,8 +533,7 @@ void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
         const auto &glyphAnchor = symbol.anchor;
 
         // drop upside down versions of glyphs
-        const float a = std::fmod(symbol.angle + collision.angle + M_PI, M_PI * 2);
-        if (keepUpright && alongLine && (a <= M_PI / 2 || a > M_PI * 3 / 2)) continue;
+        if (keepUpright && alongLine && isUpsideDown(symbol)) continue;
 
 
         if (maxZoom <= minZoom)
@@ -478,9 +547,15 @@ void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
 
         const int glyph_vertex_length = 4;
 
-        if (buffer.groups.empty() || (buffer.groups.back()->vertex_length + glyph_vertex_length > 65535)) {
-            // Move to a new group because the old one can't hold the geometry.
-            buffer.groups.emplace_back(std::make_unique<GroupType>());
+        if (!range.count) {
+            // Keep all quads of a symbol in the same group so that it can be drawn as one range.
+            const size_t symbol_vertex_length = glyph_vertex_length * symbols.size();
+            if (buffer.groups.empty() || (buffer.groups.back()->vertex_length + symbol_vertex_length > 65535)) {
+                // Move to a new group because the old one can't hold the geometry.
+                buffer.groups.emplace_back(std::make_unique<GroupType>());
+            }
+            range.group = static_cast<uint32_t>(buffer.groups.size() - 1);
+            range.first = static_cast<uint32_t>(buffer.groups.back()->elements_length);
         }
 
         // We're generating triangle fans, so we always start with the first
@@ -505,7 +580,10 @@ void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
 
         triangleGroup.vertex_length += glyph_vertex_length;
         triangleGroup.elements_length += 2;
+        range.count += 2;
     }
+
+    return range;
 }
 
 void SymbolBucket::addToDebugBuffers() {
@@ -561,46 +639,53 @@ void SymbolBucket::addToDebugBuffers() {
 }
 
 void SymbolBucket::swapRenderData() {
-    renderData = std::move(renderDataInProgress);
+    // There's nothing to swap if the last placement reused the existing buffers.
+    if (renderDataInProgress) {
+        renderData = std::move(renderDataInProgress);
+    }
 }
 
-void SymbolBucket::drawGlyphs(SDFShader &shader) {
-    char *vertex_index = BUFFER_OFFSET(0);
-    char *elements_index = BUFFER_OFFSET(0);
-    auto& text = renderData->text;
-    for (auto &group : text.groups) {
-        assert(group);
-        group->array[0].bind(shader, text.vertices, text.triangles, vertex_index);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * text.vertices.itemSize;
-        elements_index += group->elements_length * text.triangles.itemSize;
-    }
+std::vector<PlacedSymbol>* SymbolBucket::getPlacedSymbols() {
+    return renderData ? &renderData->symbols : nullptr;
 }
 
-void SymbolBucket::drawIcons(SDFShader &shader) {
+template <typename Buffer, typename Shader>
+void SymbolBucket::drawSymbols(Buffer &buffer, Shader &shader, PlacedSymbol::Range PlacedSymbol::*range, const OpacitySetter &setOpacity) {
     char *vertex_index = BUFFER_OFFSET(0);
     char *elements_index = BUFFER_OFFSET(0);
-    auto& icon = renderData->icon;
-    for (auto &group : icon.groups) {
-        assert(group);
-        group->array[0].bind(shader, icon.vertices, icon.triangles, vertex_index);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * icon.vertices.itemSize;
-        elements_index += group->elements_length * icon.triangles.itemSize;
-    }
+    uint32_t g = 0;
+    bool bound = false;
+
+    forEachDrawRun(renderData->symbols, range, [&](const PlacedSymbol::Range& run, float opacity) {
+        // Groups without anything to draw are skipped.
+        for (; g < run.group; g++) {
+            vertex_index += buffer.groups[g]->vertex_length * buffer.vertices.itemSize;
+            elements_index += buffer.groups[g]->elements_length * buffer.triangles.itemSize;
+            bound = false;
+        }
+
+        if (!bound) {
+            assert(buffer.groups[g]);
+            buffer.groups[g]->array[0].bind(shader, buffer.vertices, buffer.triangles, vertex_index);
+            bound = true;
+        }
+
+        setOpacity(opacity);
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, run.count * 3, GL_UNSIGNED_SHORT,
+            elements_index + buffer.triangles.getOffset() + run.first * buffer.triangles.itemSize));
+    });
 }
 
-void SymbolBucket::drawIcons(IconShader &shader) {
-    char *vertex_index = BUFFER_OFFSET(0);
-    char *elements_index = BUFFER_OFFSET(0);
-    auto& icon = renderData->icon;
-    for (auto &group : icon.groups) {
-        assert(group);
-        group->array[1].bind(shader, icon.vertices, icon.triangles, vertex_index);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * icon.vertices.itemSize;
-        elements_index += group->elements_length * icon.triangles.itemSize;
-    }
+void SymbolBucket::drawGlyphs(SDFShader &shader, const OpacitySetter &setOpacity) {
+    drawSymbols(renderData->text, shader, &PlacedSymbol::text, setOpacity);
+}
+
+void SymbolBucket::drawIcons(SDFShader &shader, const OpacitySetter &setOpacity) {
+    drawSymbols(renderData->icon, shader, &PlacedSymbol::icon, setOpacity);
+}
+
+void SymbolBucket::drawIcons(IconShader &shader, const OpacitySetter &setOpacity) {
+    drawSymbols(renderData->icon, shader, &PlacedSymbol::icon, setOpacity);
 }
 
 void SymbolBucket::drawCollisionBoxes(CollisionBoxShader &shader) {
@@ -16,7 +16,9 @@
 #include <mbgl/style/style_layout.hpp>
 
 #include <memory>
+#include <functional>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace mbgl {
@@ -58,6 +60,54 @@ class SymbolInstance {
         CollisionFeature iconCollisionFeature;
 };
 
+// A symbol instance that has geometry in the render buffers, along with its collision boxes
+// so that CrossTilePlacement can check it against the symbols of other tiles.
+struct PlacedSymbol {
+    // Triangles of the symbol's glyphs or icon within one element group.
+    struct Range {
+        uint32_t group = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    std::vector<CollisionBox> textBoxes;
+    std::vector<CollisionBox> iconBoxes;
+    float textScale = 0;
+    float iconScale = 0;
+    Range text;
+    Range icon;
+
+    // Set by CrossTilePlacement. Symbols that haven't been placed yet are negative and drawn
+    // fully opaque.
+    float opacity = -1;
+};
+
+// Calls fn(const PlacedSymbol::Range&, float opacity) for every range of triangles that can be
+// drawn with a single call: adjacent symbols in the same element group with the same opacity are
+// merged, and invisible ones are skipped. Usually all symbols are fully opaque, and each group is
+// drawn at once. The symbols must be sorted by their position in the buffer.
+template <typename Fn>
+void forEachDrawRun(const std::vector<PlacedSymbol>& symbols, PlacedSymbol::Range PlacedSymbol::*range, Fn fn) {
+    PlacedSymbol::Range run;
+    float runOpacity = 1;
+
+    for (const PlacedSymbol& symbol : symbols) {
+        const PlacedSymbol::Range& r = symbol.*range;
+        if (!r.count) continue;
+
+        const float opacity = symbol.opacity < 0 ? 1 : symbol.opacity;
+        if (r.group == run.group && r.first == run.first + run.count && opacity == runOpacity) {
+            run.count += r.count;
+        } else {
+            if (run.count && runOpacity > 0) fn(run, runOpacity);
+            run = r;
+            runOpacity = opacity;
+        }
+    }
+
+    if (run.count && runOpacity > 0) fn(run, runOpacity);
+}
+
 class SymbolBucket : public Bucket {
     typedef ElementGroup<1> TextElementGroup;
     typedef ElementGroup<2> IconElementGroup;
@@ -79,15 +129,26 @@ public:
                      GlyphAtlas&,
                      GlyphStore&);
 
-    void drawGlyphs(SDFShader& shader);
-    void drawIcons(SDFShader& shader);
-    void drawIcons(IconShader& shader);
+    // Symbols are drawn in runs of equal opacity; setOpacity is invoked before each run.
+    typedef std::function<void (float opacity)> OpacitySetter;
+
+    void drawGlyphs(SDFShader& shader, const OpacitySetter& setOpacity);
+    void drawIcons(SDFShader& shader, const OpacitySetter& setOpacity);
+    void drawIcons(IconShader& shader, const OpacitySetter& setOpacity);
     void drawCollisionBoxes(CollisionBoxShader& shader);
 
-    bool needsDependencies(const GeometryTileLayer&,
-                           const FilterExpression&,
-                           GlyphStore&,
-                           Sprite&);
+    // Symbols in the current render data. Must only be used on the map thread.
+    std::vector<PlacedSymbol>* getPlacedSymbols();
+    const CollisionTile& getCollisionTile() const { return collision; }
+
+    // Identifies the glyph positions in the GlyphAtlas that the text buffers refer to.
+    uintptr_t getGlyphAtlasUID() const { return glyphAtlasUID; }
+    uint32_t getGlyphGeneration() const { return glyphGeneration; }
+
+    // Extracts the labels and icons of the features that pass the filter. This only needs to be
+    // done once; a bucket that is waiting for its dependencies keeps them for the next parse.
+    void parseFeatures(const GeometryTileLayer&, const FilterExpression&);
+    bool needsDependencies(GlyphStore&, Sprite&);
     void placeFeatures() override;
 
 private:
@@ -102,9 +163,15 @@ private:
     void placeFeatures(bool swapImmediately);
     void swapRenderData() override;
 
-    // Adds placed items to the buffer.
+    // Whether a glyph is drawn upside down at the current angle.
+    bool isUpsideDown(const SymbolQuad &symbol) const;
+
+    // Adds placed items to the buffer and returns the triangles that were added.
     template <typename Buffer, typename GroupType>
-    void addSymbols(Buffer &buffer, const SymbolQuads &symbols, float scale, const bool keepUpright, const bool alongLine);
+    PlacedSymbol::Range addSymbols(Buffer &buffer, const SymbolQuads &symbols, float scale, const bool keepUpright, const bool alongLine);
+
+    template <typename Buffer, typename Shader>
+    void drawSymbols(Buffer &buffer, Shader &shader, PlacedSymbol::Range PlacedSymbol::*range, const OpacitySetter &setOpacity);
 
 public:
     StyleLayoutSymbol layout;
@@ -115,6 +182,9 @@ private:
     const float overscaling;
     std::vector<SymbolInstance> symbolInstances;
     std::vector<SymbolFeature> features;
+    std::set<GlyphRange> ranges;
+    uintptr_t glyphAtlasUID = 0;
+    uint32_t glyphGeneration = 0;
 
     struct SymbolRenderData {
         struct TextBuffer {
@@ -133,10 +203,22 @@ private:
             CollisionBoxVertexBuffer vertices;
             std::vector<std::unique_ptr<CollisionBoxElementGroup>> groups;
         } collisionBox;
+
+        std::vector<PlacedSymbol> symbols;
     };
 
     std::unique_ptr<SymbolRenderData> renderData;
     std::unique_ptr<SymbolRenderData> renderDataInProgress;
+
+    // Everything the buffers of the last placement were built from: the text and icon scale
+    // of each symbol instance and, for labels kept upright, which quads were dropped.
+    struct Placement {
+        std::vector<float> scales;
+        std::vector<bool> upsideDown;
+        bool debug = false;
+    };
+
+    std::unique_ptr<Placement> lastPlacement;
 };
 
 }
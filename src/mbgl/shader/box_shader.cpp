@@ -1,5 +1,6 @@
 #include <mbgl/shader/box_shader.hpp>
 #include <mbgl/shader/shaders.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 #include <mbgl/platform/gl.hpp>
 
 #include <cstdio>
@@ -18,15 +19,7 @@ CollisionBoxShader::CollisionBoxShader()
 }
 
 void CollisionBoxShader::bind(char *offset) {
-    const int stride = 12;
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_pos, 2, GL_SHORT, false, stride, offset + 0));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_extrude));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_extrude, 2, GL_SHORT, false, stride, offset + 4));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_data));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_data, 2, GL_UNSIGNED_BYTE, false, stride, offset + 8));
-
+    CollisionBoxVertexLayout::bind<CollisionBoxVertexLayout::pos>(a_pos, offset);
+    CollisionBoxVertexLayout::bind<CollisionBoxVertexLayout::extrude>(a_extrude, offset);
+    CollisionBoxVertexLayout::bind<CollisionBoxVertexLayout::data>(a_data, offset);
 }
@@ -1,5 +1,6 @@
 #include <mbgl/shader/linesdf_shader.hpp>
 #include <mbgl/shader/shaders.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 #include <mbgl/platform/gl.hpp>
 
 #include <cstdio>
@@ -17,9 +18,6 @@ LineSDFShader::LineSDFShader()
 }
 
 void LineSDFShader::bind(char *offset) {
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_pos, 2, GL_SHORT, false, 8, offset + 0));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_data));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_data, 4, GL_BYTE, false, 8, offset + 4));
+    LineVertexLayout::bind<LineVertexLayout::pos>(a_pos, offset);
+    LineVertexLayout::bind<LineVertexLayout::data>(a_data, offset);
 }
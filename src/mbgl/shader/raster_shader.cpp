@@ -1,5 +1,6 @@
 #include <mbgl/shader/raster_shader.hpp>
 #include <mbgl/shader/shaders.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 #include <mbgl/platform/gl.hpp>
 
 #include <cstdio>
@@ -16,6 +17,5 @@ RasterShader::RasterShader()
 }
 
 void RasterShader::bind(char *offset) {
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_pos, 2, GL_SHORT, false, 0, offset));
+    FillVertexLayout::bind<FillVertexLayout::pos>(a_pos, offset);
 }
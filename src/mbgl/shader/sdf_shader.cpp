@@ -1,5 +1,6 @@
 #include <mbgl/shader/sdf_shader.hpp>
 #include <mbgl/shader/shaders.hpp>
+#include <mbgl/geometry/vertex_layout.hpp>
 #include <mbgl/platform/gl.hpp>
 
 #include <cstdio>
@@ -19,33 +20,15 @@ SDFShader::SDFShader()
 }
 
 void SDFGlyphShader::bind(char *offset) {
-    const int stride = 16;
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_pos, 2, GL_SHORT, false, stride, offset + 0));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_offset));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_offset, 2, GL_SHORT, false, stride, offset + 4));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_data1));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_data1, 4, GL_UNSIGNED_BYTE, false, stride, offset + 8));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_data2));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_data2, 4, GL_UNSIGNED_BYTE, false, stride, offset + 12));
+    SymbolVertexLayout::bind<SymbolVertexLayout::pos>(a_pos, offset);
+    SymbolVertexLayout::bind<SymbolVertexLayout::offset>(a_offset, offset);
+    SymbolVertexLayout::bind<SymbolVertexLayout::data1>(a_data1, offset);
+    SymbolVertexLayout::bind<SymbolVertexLayout::data2>(a_data2, offset);
 }
 
 void SDFIconShader::bind(char *offset) {
-    const int stride = 16;
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_pos, 2, GL_SHORT, false, stride, offset + 0));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_offset));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_offset, 2, GL_SHORT, false, stride, offset + 4));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_data1));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_data1, 4, GL_UNSIGNED_BYTE, false, stride, offset + 8));
-
-    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_data2));
-    MBGL_CHECK_ERROR(glVertexAttribPointer(a_data2, 4, GL_UNSIGNED_BYTE, false, stride, offset + 12));
+    SymbolVertexLayout::bind<SymbolVertexLayout::pos>(a_pos, offset);
+    SymbolVertexLayout::bind<SymbolVertexLayout::offset>(a_offset, offset);
+    SymbolVertexLayout::bind<SymbolVertexLayout::data1>(a_data1, offset);
+    SymbolVertexLayout::bind<SymbolVertexLayout::data2>(a_data2, offset);
 }
@@ -32,7 +32,7 @@ void AppliedClassPropertyValues::cleanup(const TimePoint& now) {
             // Removes all items that precede the current iterator, but *not* the element currently
             // pointed to by the iterator. This preserves the last completed transition as the
             // first element in the property list.
-            propertyValues.erase(begin, it);
+            it = propertyValues.erase(begin, it);
 
             // Also erase the pivot element if it's a fallback value. This means we can remove the
             // entire applied properties object as well, because we already have the fallback
@@ -5,7 +5,7 @@
 #include <mbgl/style/class_dictionary.hpp>
 #include <mbgl/util/chrono.hpp>
 
-#include <list>
+#include <vector>
 
 namespace mbgl {
 
@@ -14,16 +14,17 @@ public:
     AppliedClassPropertyValue(ClassID class_id, const TimePoint& begin, const TimePoint& end, const PropertyValue &value);
 
 public:
-    const ClassID name;
-    const TimePoint begin;
-    const TimePoint end;
-    const PropertyValue value;
+    ClassID name;
+    TimePoint begin;
+    TimePoint end;
+    PropertyValue value;
 };
 
 
 class AppliedClassPropertyValues {
 public:
-    std::list<AppliedClassPropertyValue> propertyValues;
+    // Usually holds a single value, or two while a transition is in progress.
+    std::vector<AppliedClassPropertyValue> propertyValues;
 
 public:
     // Returns the ID of the most recent
@@ -14,6 +14,8 @@ public:
     inline ClassProperties() {}
     inline ClassProperties(ClassProperties &&properties_)
         : properties(std::move(properties_.properties)) {}
+    inline ClassProperties(const ClassProperties &properties_)
+        : properties(properties_.properties), transitions(properties_.transitions) {}
 
     inline void set(PropertyKey key, const PropertyValue &value) {
         properties.emplace(key, value);
@@ -2,6 +2,7 @@
 #include <mbgl/style/types.hpp>
 #include <mbgl/util/interpolate.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 namespace mbgl {
@@ -27,50 +28,87 @@ template <> inline TextTransformType defaultStopsValue() { return {}; };
 template <> inline RotationAlignmentType defaultStopsValue() { return {}; };
 
 template <typename T>
-T StopsFunction<T>::evaluate(float z) const {
-    bool smaller = false;
-    float smaller_z = 0.0f;
-    T smaller_val = T();
-    bool larger = false;
-    float larger_z = 0.0f;
-    T larger_val = T();
-
-    for (uint32_t i = 0; i < values.size(); i++) {
-        float stop_z = values[i].first;
-        T stop_val = values[i].second;
-        if (stop_z <= z && (!smaller || smaller_z < stop_z)) {
-            smaller = true;
-            smaller_z = stop_z;
-            smaller_val = stop_val;
-        }
-        if (stop_z >= z && (!larger || larger_z > stop_z)) {
-            larger = true;
-            larger_z = stop_z;
-            larger_val = stop_val;
+StopsFunction<T>::StopsFunction(const std::vector<std::pair<float, T>> &stops, float base_)
+    : base(base_) {
+    std::vector<std::pair<float, T>> sorted = stops;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (const auto& stop : sorted) {
+        // Of several stops at the same zoom level, only the first one is ever used.
+        if (!zooms.empty() && zooms.back() == stop.first) {
+            continue;
         }
+        zooms.push_back(stop.first);
+        values.push_back(stop.second);
     }
 
-    if (smaller && larger) {
-        if (larger_z == smaller_z || larger_val == smaller_val) {
-            return smaller_val;
+    if (base != 1.0f) {
+        for (size_t i = 1; i < zooms.size(); i++) {
+            denominators.push_back(std::pow(base, zooms[i] - zooms[i - 1]) - 1);
         }
-        const float zoomDiff = larger_z - smaller_z;
-        const float zoomProgress = z - smaller_z;
-        if (base == 1.0f) {
-            const float t = zoomProgress / zoomDiff;
-            return util::interpolate(smaller_val, larger_val, t);
-        } else {
-            const float t = (std::pow(base, zoomProgress) - 1) / (std::pow(base, zoomDiff) - 1);
-            return util::interpolate(smaller_val, larger_val, t);
-        }
-    } else if (larger) {
-        return larger_val;
-    } else if (smaller) {
-        return smaller_val;
-    } else {
+    }
+}
+
+template <typename T>
+T StopsFunction<T>::evaluate(float z) const {
+    if (zooms.empty()) {
         // No stop defined.
         return defaultStopsValue<T>();
     }
+
+    // The first stop at or above z.
+    const auto it = std::lower_bound(zooms.begin(), zooms.end(), z);
+    if (it == zooms.end()) {
+        return values.back();
+    }
+
+    const size_t larger = it - zooms.begin();
+    if (*it == z || larger == 0) {
+        return values[larger];
+    }
+
+    const size_t smaller = larger - 1;
+    if (values[smaller] == values[larger]) {
+        return values[smaller];
+    }
+
+    const float zoomProgress = z - zooms[smaller];
+    if (base == 1.0f) {
+        const float t = zoomProgress / (zooms[larger] - zooms[smaller]);
+        return util::interpolate(values[smaller], values[larger], t);
+    } else {
+        const float t = (std::pow(base, zoomProgress) - 1) / denominators[smaller];
+        return util::interpolate(values[smaller], values[larger], t);
+    }
+}
+
+template <typename T>
+std::pair<float, float> StopsFunction<T>::getConstantRange(float z) const {
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    if (zooms.empty()) {
+        return { -infinity, infinity };
+    }
+
+    const auto it = std::lower_bound(zooms.begin(), zooms.end(), z);
+    if (it == zooms.end()) {
+        return { zooms.back(), infinity };
+    }
+
+    const size_t larger = it - zooms.begin();
+    if (*it == z) {
+        return { z, z };
+    } else if (larger == 0) {
+        return { -infinity, zooms.front() };
+    }
+
+    const size_t smaller = larger - 1;
+    if (values[smaller] == values[larger]) {
+        return { zooms[smaller], zooms[larger] };
+    }
+    return { z, z };
 }
 
 template bool StopsFunction<bool>::evaluate(float z) const;
@@ -89,4 +127,38 @@ template TextAnchorType StopsFunction<TextAnchorType>::evaluate(float z) const;
 template TextJustifyType StopsFunction<TextJustifyType>::evaluate(float z) const;
 template TextTransformType StopsFunction<TextTransformType>::evaluate(float z) const;
 template RotationAlignmentType StopsFunction<RotationAlignmentType>::evaluate(float z) const;
+
+template StopsFunction<bool>::StopsFunction(const std::vector<std::pair<float, bool>> &stops, float base);
+template StopsFunction<float>::StopsFunction(const std::vector<std::pair<float, float>> &stops, float base);
+template StopsFunction<Color>::StopsFunction(const std::vector<std::pair<float, Color>> &stops, float base);
+template StopsFunction<std::vector<float>>::StopsFunction(const std::vector<std::pair<float, std::vector<float>>> &stops, float base);
+template StopsFunction<std::array<float, 2>>::StopsFunction(const std::vector<std::pair<float, std::array<float, 2>>> &stops, float base);
+
+template StopsFunction<std::string>::StopsFunction(const std::vector<std::pair<float, std::string>> &stops, float base);
+template StopsFunction<TranslateAnchorType>::StopsFunction(const std::vector<std::pair<float, TranslateAnchorType>> &stops, float base);
+template StopsFunction<RotateAnchorType>::StopsFunction(const std::vector<std::pair<float, RotateAnchorType>> &stops, float base);
+template StopsFunction<CapType>::StopsFunction(const std::vector<std::pair<float, CapType>> &stops, float base);
+template StopsFunction<JoinType>::StopsFunction(const std::vector<std::pair<float, JoinType>> &stops, float base);
+template StopsFunction<PlacementType>::StopsFunction(const std::vector<std::pair<float, PlacementType>> &stops, float base);
+template StopsFunction<TextAnchorType>::StopsFunction(const std::vector<std::pair<float, TextAnchorType>> &stops, float base);
+template StopsFunction<TextJustifyType>::StopsFunction(const std::vector<std::pair<float, TextJustifyType>> &stops, float base);
+template StopsFunction<TextTransformType>::StopsFunction(const std::vector<std::pair<float, TextTransformType>> &stops, float base);
+template StopsFunction<RotationAlignmentType>::StopsFunction(const std::vector<std::pair<float, RotationAlignmentType>> &stops, float base);
+
+template std::pair<float, float> StopsFunction<bool>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<float>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<Color>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<std::vector<float>>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<std::array<float, 2>>::getConstantRange(float z) const;
+
+template std::pair<float, float> StopsFunction<std::string>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<TranslateAnchorType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<RotateAnchorType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<CapType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<JoinType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<PlacementType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<TextAnchorType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<TextJustifyType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<TextTransformType>::getConstantRange(float z) const;
+template std::pair<float, float> StopsFunction<RotationAlignmentType>::getConstantRange(float z) const;
 }
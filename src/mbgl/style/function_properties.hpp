@@ -3,6 +3,8 @@
 
 #include <mbgl/util/variant.hpp>
 
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -11,19 +13,34 @@ template <typename T>
 struct ConstantFunction {
     inline ConstantFunction(const T &value_) : value(value_) {}
     inline T evaluate(float) const { return value; }
+    inline bool operator==(const ConstantFunction &other) const { return value == other.value; }
 
 private:
     const T value;
 };
 
+// Stops are sorted by zoom level when the function is created, so that evaluating it is a binary
+// search followed by an interpolation between two stops.
 template <typename T>
 struct StopsFunction {
-    inline StopsFunction(const std::vector<std::pair<float, T>> &values_, float base_) : values(values_), base(base_) {}
+    StopsFunction(const std::vector<std::pair<float, T>> &stops, float base);
     T evaluate(float z) const;
 
+    // Returns the zoom levels around z (inclusive) at which the function evaluates to the same
+    // value as at z.
+    std::pair<float, float> getConstantRange(float z) const;
+
+    inline bool operator==(const StopsFunction &other) const {
+        return base == other.base && zooms == other.zooms && values == other.values;
+    }
+
 private:
-    const std::vector<std::pair<float, T>> values;
-    const float base;
+    std::vector<float> zooms;
+    std::vector<T> values;
+
+    // pow(base, zoom difference) - 1 between each stop and the next; empty for linear functions.
+    std::vector<float> denominators;
+    float base;
 };
 
 template <typename T>
@@ -33,6 +50,18 @@ using Function = mapbox::util::variant<
     StopsFunction<T>
 >;
 
+// Evaluates a function without dispatching through a visitor.
+template <typename T>
+inline T evaluateFunction(const Function<T> &fn, float z) {
+    if (fn.template is<StopsFunction<T>>()) {
+        return fn.template get<StopsFunction<T>>().evaluate(z);
+    } else if (fn.template is<ConstantFunction<T>>()) {
+        return fn.template get<ConstantFunction<T>>().evaluate(z);
+    } else {
+        return T();
+    }
+}
+
 template <typename T>
 struct FunctionEvaluator {
     typedef T result_type;
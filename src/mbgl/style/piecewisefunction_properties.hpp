@@ -3,6 +3,7 @@
 
 #include <mbgl/style/zoom_history.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace mbgl {
@@ -13,6 +14,18 @@ struct PiecewiseConstantFunction {
     inline PiecewiseConstantFunction(T &value, std::chrono::duration<float> duration_) : values({{ 0, value }}), duration(duration_) {}
     T evaluate(float z, const ZoomHistory &zoomHistory) const;
 
+    inline bool operator==(const PiecewiseConstantFunction &other) const {
+        return duration == other.duration && std::equal(values.begin(), values.end(), other.values.begin(), other.values.end(),
+            [](const std::pair<float, T> &a, const std::pair<float, T> &b) {
+                return a.first == b.first && a.second.to == b.second.to;
+            });
+    }
+
+    // Whether the result is still fading between the values of the last two integer zoom levels.
+    inline bool isFading(const ZoomHistory &zoomHistory) const {
+        return Clock::now() - zoomHistory.lastIntegerZoomTime < duration;
+    }
+
 private:
     const std::vector<std::pair<float, T>> values;
     const std::chrono::duration<float> duration;
@@ -95,6 +95,9 @@ enum class PropertyKey {
     Visibilty
 };
 
+// Number of property keys, for tables that are indexed by PropertyKey.
+const unsigned PropertyKeyCount = static_cast<unsigned>(PropertyKey::Visibilty) + 1;
+
 }
 
 #endif
@@ -8,6 +8,8 @@
 #include <mbgl/style/style_parser.hpp>
 #include <mbgl/style/style_bucket.hpp>
 #include <mbgl/style/property_transition.hpp>
+#include <mbgl/style/style_layout.hpp>
+#include <mbgl/style/function_properties.hpp>
 #include <mbgl/geometry/glyph_atlas.hpp>
 #include <mbgl/geometry/sprite_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
@@ -17,14 +19,138 @@
 #include <csscolorparser/csscolorparser.hpp>
 
 #include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
 
 #include <algorithm>
+#include <cmath>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
+namespace {
+
+// Styles with fewer layers are cascaded on the map thread alone.
+const std::size_t parallelCascadeThreshold = 64;
+
+// Collects the font stacks that symbol layers with text may use at any zoom level.
+std::set<std::string> getFontStacks(const std::vector<util::ptr<StyleLayer>>& layers) {
+    std::set<std::string> fontStacks;
+
+    for (const auto& layer : layers) {
+        const auto& bucket = layer->bucket;
+        if (!bucket || bucket->type != StyleLayerType::Symbol) {
+            continue;
+        }
+
+        const auto& properties = bucket->layout.properties;
+        if (properties.find(PropertyKey::TextField) == properties.end()) {
+            continue;
+        }
+
+        auto it = properties.find(PropertyKey::TextFont);
+        if (it == properties.end() || !it->second.is<Function<std::string>>()) {
+            fontStacks.insert(defaultStyleLayout<StyleLayoutSymbol>().text.font);
+            continue;
+        }
+
+        const auto& font = it->second.get<Function<std::string>>();
+        const int minZoom = std::max(0.0f, std::floor(bucket->min_zoom));
+        const int maxZoom = std::min(22.0f, std::ceil(bucket->max_zoom));
+        for (int z = minZoom; z <= maxZoom; ++z) {
+            fontStacks.insert(evaluateFunction(font, z));
+        }
+    }
+
+    return fontStacks;
+}
+
+std::string serialize(const rapidjson::Value& value) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return { buffer.GetString(), buffer.Size() };
+}
+
+// Serializes the members of an object that are listed in keys, in that order.
+std::string serialize(const rapidjson::Value& value, std::initializer_list<const char*> keys) {
+    std::string result;
+    for (const char* key : keys) {
+        if (value.HasMember(key)) {
+            result += key;
+            result += serialize(value[key]);
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+struct StyleDefinitions {
+    std::string global;
+    std::unordered_map<std::string, std::string> sources;
+    std::unordered_map<std::string, std::string> buckets;
+};
+
+StyleDefinitions getDefinitions(const rapidjson::Value& document) {
+    StyleDefinitions definitions;
+    definitions.global = serialize(document, { "constants", "sprite", "glyphs" });
+
+    if (document.HasMember("sources") && document["sources"].IsObject()) {
+        const auto& sources = document["sources"];
+        for (auto it = sources.MemberBegin(); it != sources.MemberEnd(); ++it) {
+            definitions.sources.emplace(std::string { it->name.GetString(), it->name.GetStringLength() },
+                                        serialize(it->value));
+        }
+    }
+
+    if (document.HasMember("layers") && document["layers"].IsArray()) {
+        const auto& layers = document["layers"];
+        for (rapidjson::SizeType i = 0; i < layers.Size(); ++i) {
+            const auto& layer = layers[i];
+            if (!layer.IsObject() || !layer.HasMember("id") || !layer["id"].IsString()) {
+                continue;
+            }
+            definitions.buckets.emplace(std::string { layer["id"].GetString(), layer["id"].GetStringLength() },
+                                        serialize(layer, { "type", "ref", "source", "source-layer", "filter",
+                                                           "layout", "minzoom", "maxzoom" }));
+        }
+    }
+
+    return definitions;
+}
+
+// Parses a JSON value into an object with a single member, like the paint or layout object of a
+// layer. The member refers to the memory of the document.
+bool parseProperty(rapidjson::Document& doc, rapidjson::Value& object, const std::string& name,
+                   const std::string& value) {
+    doc.Parse<0>(value.c_str());
+    if (doc.HasParseError()) {
+        Log::Error(Event::ParseStyle, "Error parsing value of '%s' at %i: %s", name.c_str(),
+                   doc.GetErrorOffset(), doc.GetParseError());
+        return false;
+    }
+
+    object.SetObject();
+    object.AddMember(name.c_str(), doc, doc.GetAllocator());
+    return true;
+}
+
+// Layers and sources that aren't defined in the JSON, like the annotation ones, have an empty
+// definition.
+const std::string& getDefinition(const std::unordered_map<std::string, std::string>& definitions,
+                                 const std::string& id) {
+    static const std::string empty;
+    const auto it = definitions.find(id);
+    return it != definitions.end() ? it->second : empty;
+}
+
+}
+
 Style::Style(MapData& data_, uv_loop_t*)
     : data(data_),
-      glyphStore(std::make_unique<GlyphStore>()),
+      glyphStore(std::make_unique<GlyphStore>(workers)),
       glyphAtlas(std::make_unique<GlyphAtlas>(1024, 1024)),
       spriteStore(std::make_unique<SpriteStore>()),
       spriteAtlas(std::make_unique<SpriteAtlas>(512, 512, data.pixelRatio, *spriteStore)),
@@ -36,7 +162,7 @@ Style::Style(MapData& data_, uv_loop_t*)
 
 void Style::setJSON(const std::string& json, const std::string&) {
     rapidjson::Document doc;
-    doc.Parse<0>((const char *const)json.c_str());
+    doc.Parse<0>(json.c_str());
     if (doc.HasParseError()) {
         Log::Error(Event::ParseStyle, "Error parsing style JSON at %i: %s", doc.GetErrorOffset(), doc.GetParseError());
         return;
@@ -53,10 +179,226 @@ void Style::setJSON(const std::string& json, const std::string&) {
 
     glyphStore->setURL(parser.getGlyphURL());
 
+    prefetchGlyphs();
+
     for (const auto& source : sources) {
         source->setObserver(this);
         source->load();
     }
+
+    StyleDefinitions definitions = getDefinitions(doc);
+    globalDefinition = std::move(definitions.global);
+    sourceDefinitions = std::move(definitions.sources);
+    bucketDefinitions = std::move(definitions.buckets);
+}
+
+bool Style::diffJSON(const std::string& json) {
+    if (layers.empty()) {
+        return false;
+    }
+
+    rapidjson::Document doc;
+    doc.Parse<0>(json.c_str());
+    if (doc.HasParseError()) {
+        return false;
+    }
+
+    StyleDefinitions definitions = getDefinitions(doc);
+    if (definitions.global != globalDefinition) {
+        return false;
+    }
+
+    StyleParser parser(data);
+    parser.parse(doc);
+
+    // Keep the sources that are defined the same way, so that their tiles don't have to be loaded
+    // again.
+    std::vector<std::unique_ptr<Source>> newSources = parser.getSources();
+    std::set<std::string> changedSources;
+    for (auto& source : newSources) {
+        const InternedString& id = source->info.source_id;
+        auto it = std::find_if(sources.begin(), sources.end(), [&](const auto& old) {
+            return old && old->info.source_id == id;
+        });
+
+        if (it != sources.end() && getDefinition(sourceDefinitions, id) == getDefinition(definitions.sources, id)) {
+            source = std::move(*it);
+        } else {
+            source->setObserver(this);
+            source->load();
+            changedSources.insert(id);
+        }
+    }
+
+    for (const auto& source : sources) {
+        if (source) {
+            source->setObserver(nullptr);
+        }
+    }
+
+    // Buckets are keyed by the ID of the layer that defines them. Tiles parse the buckets that
+    // changed again and keep the others.
+    std::unordered_map<InternedString, std::unordered_set<InternedString>> changedBuckets;
+    std::unordered_map<std::string, util::ptr<StyleLayer>> oldLayers;
+    for (const auto& layer : layers) {
+        oldLayers.emplace(layer->id, layer);
+    }
+
+    std::vector<util::ptr<StyleLayer>> newLayers = parser.getLayers();
+
+    for (const auto& layer : newLayers) {
+        const auto old = oldLayers.find(layer->id);
+
+        if (layer->bucket) {
+            const std::string& name = layer->bucket->name;
+            const auto oldBucket = oldLayers.find(name);
+            if (oldBucket != oldLayers.end() && oldBucket->second->bucket &&
+                oldBucket->second->bucket->source == layer->bucket->source &&
+                !changedSources.count(layer->bucket->source) &&
+                getDefinition(bucketDefinitions, name) == getDefinition(definitions.buckets, name)) {
+                layer->bucket = oldBucket->second->bucket;
+            } else {
+                changedBuckets[layer->bucket->source].insert(layer->bucket->name);
+                if (oldBucket != oldLayers.end() && oldBucket->second->bucket) {
+                    // Drops the bucket from the tiles of the source it used to come from.
+                    changedBuckets[oldBucket->second->bucket->source].insert(layer->bucket->name);
+                }
+            }
+        }
+
+        if (old != oldLayers.end()) {
+            layer->inheritProperties(*old->second);
+        }
+    }
+
+    // Tiles may still contain the buckets of removed layers, but nothing renders them anymore.
+    sources = std::move(newSources);
+    layers = std::move(newLayers);
+
+    for (const auto& source : sources) {
+        if (changedSources.count(source->info.source_id)) {
+            source->invalidateTiles({});
+            continue;
+        }
+
+        const auto buckets = changedBuckets.find(source->info.source_id);
+        if (buckets != changedBuckets.end()) {
+            for (const auto& name : buckets->second) {
+                source->invalidateBucket(name);
+            }
+            shouldReparsePartialTiles = true;
+        }
+    }
+
+    sourceDefinitions = std::move(definitions.sources);
+    bucketDefinitions = std::move(definitions.buckets);
+
+    prefetchGlyphs();
+
+    return true;
+}
+
+bool Style::setPaintProperty(const std::string& layerID, const std::string& name, const std::string& value,
+                             const std::string& klass) {
+    const auto it = std::find_if(layers.begin(), layers.end(), [&](const auto& layer) {
+        return layer->id == layerID;
+    });
+    if (it == layers.end()) {
+        Log::Warning(Event::Style, "can't set '%s' of unknown layer '%s'", name.c_str(), layerID.c_str());
+        return false;
+    }
+
+    rapidjson::Document doc;
+    rapidjson::Value object;
+    if (!parseProperty(doc, object, name, value)) {
+        return false;
+    }
+
+    ClassProperties properties;
+    StyleParser(data).parsePaint(object, properties);
+    if (properties.properties.empty() && properties.transitions.empty()) {
+        Log::Warning(Event::Style, "'%s' is not a paint property", name.c_str());
+        return false;
+    }
+
+    const ClassID classID = klass.empty() ? ClassID::Default : ClassDictionary::Get().lookup(klass);
+    (*it)->setPaintProperties(classID, properties);
+    return true;
+}
+
+bool Style::setLayoutProperty(const std::string& layerID, const std::string& name, const std::string& value) {
+    const auto it = std::find_if(layers.begin(), layers.end(), [&](const auto& layer) {
+        return layer->id == layerID;
+    });
+    if (it == layers.end() || !(*it)->bucket) {
+        Log::Warning(Event::Style, "can't set '%s' of unknown layer '%s'", name.c_str(), layerID.c_str());
+        return false;
+    }
+
+    rapidjson::Document doc;
+    rapidjson::Value object;
+    if (!parseProperty(doc, object, name, value)) {
+        return false;
+    }
+
+    const util::ptr<const StyleBucket> oldBucket = (*it)->bucket;
+    util::ptr<StyleBucket> parsed = std::make_shared<StyleBucket>(oldBucket->type);
+    parsed->visibility = oldBucket->visibility;
+    StyleParser(data).parseLayout(object, parsed);
+    if (parsed->layout.properties.empty() && parsed->visibility == oldBucket->visibility) {
+        if (name != "visibility") {
+            Log::Warning(Event::Style, "'%s' is not a layout property", name.c_str());
+        }
+        return false;
+    }
+
+    ClassProperties layout;
+    for (const auto& property : parsed->layout) {
+        layout.set(property.first, property.second);
+    }
+    for (const auto& property : oldBucket->layout) {
+        layout.set(property.first, property.second);
+    }
+    util::ptr<const StyleBucket> bucket =
+        std::make_shared<StyleBucket>(*oldBucket, std::move(layout), parsed->visibility);
+
+    // Tile workers may be reading the layers that use the old bucket, so they are replaced
+    // instead of changed.
+    for (auto& layer : layers) {
+        if (layer->bucket != oldBucket) {
+            continue;
+        }
+
+        auto replacement = std::make_shared<StyleLayer>(layer->id, std::map<ClassID, ClassProperties>(layer->styles));
+        replacement->type = layer->type;
+        replacement->bucket = bucket;
+        replacement->inheritProperties(*layer);
+        layer = replacement;
+    }
+
+    for (const auto& source : sources) {
+        if (source->info.source_id == bucket->source) {
+            source->invalidateBucket(bucket->name);
+        }
+    }
+
+    // The JSON doesn't describe this bucket anymore.
+    bucketDefinitions.erase(bucket->name);
+
+    shouldReparsePartialTiles = true;
+    prefetchGlyphs();
+
+    return true;
+}
+
+void Style::prefetchGlyphs() {
+    // Almost every label needs the Latin ranges, so load them while the sources are loading
+    // instead of having each tile wait for them.
+    for (const auto& fontStack : getFontStacks(layers)) {
+        if (!fontStack.empty()) {
+            glyphStore->prefetch(fontStack);
+        }
+    }
 }
 
 Style::~Style() {
@@ -73,6 +415,16 @@ Style::~Style() {
 
 void Style::update(const TransformState& transform,
                    TexturePool& texturePool) {
+    // Tiles whose glyphs were moved by compacting the glyph atlas rebuild their symbol buckets
+    // with the new positions.
+    const auto relocatedTiles = glyphAtlas->takeRelocatedTiles();
+    if (!relocatedTiles.empty()) {
+        for (const auto& source : sources) {
+            source->invalidateGlyphTiles(relocatedTiles);
+        }
+        shouldReparsePartialTiles = true;
+    }
+
     bool allTilesUpdated = true;
     for (const auto& source : sources) {
         if (!source->update(data, transform, *this, texturePool, shouldReparsePartialTiles)) {
@@ -88,10 +440,26 @@ void Style::update(const TransformState& transform,
 }
 
 void Style::cascade() {
-    for (const auto& layer : layers) {
-        layer->setClasses(data.getClasses(),
-                data.getAnimationTime(),
-                PropertyTransition { data.getDefaultTransitionDuration(), data.getDefaultTransitionDelay() });
+    // The class dictionary is thread-local, so the names are looked up here.
+    std::vector<ClassID> classIDs;
+    for (const auto& className : data.getClasses()) {
+        classIDs.push_back(ClassDictionary::Get().lookup(className));
+    }
+
+    const TimePoint now = data.getAnimationTime();
+    const PropertyTransition transition { data.getDefaultTransitionDuration(), data.getDefaultTransitionDelay() };
+    const auto cascadeLayer = [&](std::size_t i) {
+        layers[i]->setClassIDs(classIDs, now, transition);
+    };
+
+    // Layers are cascaded independently of each other. For small styles, handing them to the
+    // workers costs more than it saves.
+    if (layers.size() >= parallelCascadeThreshold) {
+        workers.parallelFor(layers.size(), cascadeLayer);
+    } else {
+        for (std::size_t i = 0; i < layers.size(); i++) {
+            cascadeLayer(i);
+        }
     }
 }
 
@@ -105,7 +473,12 @@ void Style::recalculate(float z) {
     zoomHistory.update(z, data.getAnimationTime());
 
     for (const auto& layer : layers) {
-        layer->updateProperties(z, data.getAnimationTime(), zoomHistory);
+        if (layer->needsUpdate(z)) {
+            layer->updateProperties(z, data.getAnimationTime(), zoomHistory);
+        } else {
+            skippedRecalculations++;
+        }
+
         if (!layer->bucket) {
             continue;
         }
@@ -119,7 +492,7 @@ void Style::recalculate(float z) {
     }
 }
 
-Source* Style::getSource(const std::string& id) const {
+Source* Style::getSource(const InternedString& id) const {
     const auto it = std::find_if(sources.begin(), sources.end(), [&](const auto& source) {
         return source->info.source_id == id;
     });
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 namespace mbgl {
 
@@ -46,6 +47,20 @@ public:
 
     void setJSON(const std::string& data, const std::string& base);
 
+    // Applies a new version of the current style in place: sources and buckets whose definitions
+    // didn't change are kept along with their tiles, and layers keep the paint properties that
+    // didn't change. Returns false if the style has to be reloaded instead, e.g. because the
+    // constants, the sprite or the glyphs changed.
+    bool diffJSON(const std::string& data);
+
+    // Changes a single property of a layer. The value is given as JSON, like in the style.
+    // Paint properties take effect with the next cascade; layout properties reparse the
+    // layer's bucket in every tile, but keep the other buckets. Return false if nothing has to
+    // be updated.
+    bool setPaintProperty(const std::string& layer, const std::string& name, const std::string& value,
+                          const std::string& klass);
+    bool setLayoutProperty(const std::string& layer, const std::string& name, const std::string& value);
+
     void setObserver(Observer*);
 
     bool isLoaded() const;
@@ -57,13 +72,19 @@ public:
     void cascade();
     void recalculate(float z);
 
+    // Number of times recalculate() didn't need to evaluate the properties of a layer because
+    // they couldn't have changed.
+    uint64_t getSkippedRecalculations() const {
+        return skippedRecalculations;
+    }
+
     bool hasTransitions() const;
 
     std::exception_ptr getLastError() const {
         return lastError;
     }
 
-    Source* getSource(const std::string& id) const;
+    Source* getSource(const InternedString& id) const;
 
     MapData& data;
     std::unique_ptr<GlyphStore> glyphStore;
@@ -91,17 +112,26 @@ private:
     void onSpriteLoaded(const Sprites& sprites) override;
     void onSpriteLoadingFailed(std::exception_ptr error) override;
 
+    void prefetchGlyphs();
+
     void emitTileDataChanged();
     void emitResourceLoadingFailed(std::exception_ptr error);
 
     bool shouldReparsePartialTiles = false;
 
+    // Serialized parts of the style JSON that diffJSON compares: everything outside of the sources
+    // and layers, each source, and the properties of each layer that its bucket depends on.
+    std::string globalDefinition;
+    std::unordered_map<std::string, std::string> sourceDefinitions;
+    std::unordered_map<std::string, std::string> bucketDefinitions;
+
     Observer* observer = nullptr;
 
     std::exception_ptr lastError;
 
     std::unique_ptr<uv::rwlock> mtx;
     ZoomHistory zoomHistory;
+    uint64_t skippedRecalculations = 0;
 
 public:
     Worker workers;
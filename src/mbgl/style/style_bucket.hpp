@@ -4,6 +4,7 @@
 #include <mbgl/style/filter_expression.hpp>
 #include <mbgl/style/class_properties.hpp>
 
+#include <mbgl/util/interned_string.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/uv.hpp>
@@ -16,9 +17,21 @@ public:
 
     inline StyleBucket(StyleLayerType type_) : type(type_) {}
 
+    // Copies a bucket with a different layout, e.g. to change the layout at runtime.
+    inline StyleBucket(const StyleBucket &bucket, ClassProperties &&layout_, VisibilityType visibility_)
+        : type(bucket.type),
+          name(bucket.name),
+          source(bucket.source),
+          source_layer(bucket.source_layer),
+          filter(bucket.filter),
+          layout(std::move(layout_)),
+          min_zoom(bucket.min_zoom),
+          max_zoom(bucket.max_zoom),
+          visibility(visibility_) {}
+
     const StyleLayerType type;
-    std::string name;
-    std::string source;
+    InternedString name;
+    InternedString source;
     std::string source_layer;
     FilterExpression filter;
     ClassProperties layout;
@@ -4,6 +4,9 @@
 
 #include <mbgl/util/interpolate.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace mbgl {
 
 StyleLayer::StyleLayer(const std::string &id_, std::map<ClassID, ClassProperties> &&styles_)
@@ -30,31 +33,47 @@ bool StyleLayer::isVisible() const {
 
 void StyleLayer::setClasses(const std::vector<std::string> &class_names, const TimePoint& now,
                             const PropertyTransition &defaultTransition) {
+    // From here on, we're only dealing with IDs to avoid comparing strings all the time.
+    std::vector<ClassID> class_ids;
+    class_ids.reserve(class_names.size());
+    for (const std::string &class_name : class_names) {
+        class_ids.push_back(ClassDictionary::Get().lookup(class_name));
+    }
+    setClassIDs(class_ids, now, defaultTransition);
+}
+
+void StyleLayer::setClassIDs(const std::vector<ClassID> &class_ids, const TimePoint& now,
+                             const PropertyTransition &defaultTransition) {
     // Stores all keys that we have already added transitions for.
-    std::set<PropertyKey> already_applied;
-
-    // Reverse iterate through all class names and apply them last to first.
-    for (auto it = class_names.rbegin(); it != class_names.rend(); ++it) {
-        const std::string &class_name = *it;
-        // From here on, we're only dealing with IDs to avoid comparing strings all the time.
-        const ClassID class_id = ClassDictionary::Get().lookup(class_name);
-        applyClassProperties(class_id, already_applied, now, defaultTransition);
+    std::bitset<PropertyKeyCount> already_applied;
+
+    // Reverse iterate through all classes and apply them last to first.
+    for (auto it = class_ids.rbegin(); it != class_ids.rend(); ++it) {
+        applyClassProperties(*it, already_applied, now, defaultTransition);
     }
 
+    // The new classes may change any property.
+    minValidZoom = std::numeric_limits<float>::infinity();
+    maxValidZoom = -std::numeric_limits<float>::infinity();
+
     // As the last class, apply the default class.
     applyClassProperties(ClassID::Default, already_applied, now, defaultTransition);
 
     // Make sure that we also transition to the fallback value for keys that aren't changed by
     // any applied classes.
-    for (auto& property_pair : appliedStyle) {
-        const PropertyKey key = property_pair.first;
-        if (already_applied.find(key) != already_applied.end()) {
+    for (size_t index = 0; index < PropertyKeyCount; ++index) {
+        if (!appliedKeys.test(index)) {
+            continue;
+        }
+
+        if (already_applied.test(index)) {
             // This property has already been set by a previous class, so we don't need to
             // transition to the fallback.
             continue;
         }
 
-        AppliedClassPropertyValues &appliedProperties = property_pair.second;
+        const PropertyKey key = static_cast<PropertyKey>(index);
+        AppliedClassPropertyValues &appliedProperties = appliedStyle[index];
         // Make sure that we don't do double transitions to the fallback value.
         if (appliedProperties.mostRecent() != ClassID::Fallback) {
             // This property key hasn't been set by a previous class, so we need to add a transition
@@ -63,13 +82,71 @@ void StyleLayer::setClasses(const std::vector<std::string> &class_names, const T
             const TimePoint end = begin + defaultTransition.duration;
             const PropertyValue &value = PropertyFallbackValue::Get(key);
             appliedProperties.add(ClassID::Fallback, begin, end, value);
+            transitioningKeys.set(index, appliedProperties.hasTransitions());
+        }
+    }
+
+    changedKeys.reset();
+}
+
+void StyleLayer::inheritProperties(const StyleLayer &previous) {
+    if (type != previous.type) {
+        return;
+    }
+
+    appliedKeys = previous.appliedKeys;
+    transitioningKeys = previous.transitioningKeys;
+
+    for (size_t index = 0; index < PropertyKeyCount; ++index) {
+        if (!appliedKeys.test(index)) {
+            continue;
+        }
+
+        appliedStyle[index].propertyValues = previous.appliedStyle[index].propertyValues;
+
+        // The fallback values don't depend on the style.
+        const ClassID class_id = appliedStyle[index].mostRecent();
+        if (class_id == ClassID::Fallback) {
+            continue;
+        }
+
+        const PropertyKey key = static_cast<PropertyKey>(index);
+        const auto style_it = styles.find(class_id);
+        if (style_it == styles.end()) {
+            changedKeys.set(index);
+            continue;
+        }
+
+        const auto& values = style_it->second.properties;
+        const auto value_it = values.find(key);
+        if (value_it == values.end() || !(value_it->second == appliedStyle[index].propertyValues.back().value)) {
+            changedKeys.set(index);
         }
     }
 }
 
+void StyleLayer::setPaintProperties(ClassID class_id, const ClassProperties &values) {
+    ClassProperties &klass = styles[class_id];
+
+    for (const auto& property : values) {
+        klass.properties[property.first] = property.second;
+
+        // Only the class whose value is currently applied needs to transition again.
+        const size_t index = static_cast<size_t>(property.first);
+        if (appliedStyle[index].mostRecent() == class_id) {
+            changedKeys.set(index);
+        }
+    }
+
+    for (const auto& transition : values.transitions) {
+        klass.transitions.erase(transition.first);
+        klass.transitions.emplace(transition.first, transition.second);
+    }
+}
+
 // Helper function for applying all properties of a a single class that haven't been applied yet.
 void StyleLayer::applyClassProperties(const ClassID class_id,
-                                      std::set<PropertyKey> &already_applied, const TimePoint& now,
+                                      std::bitset<PropertyKeyCount> &already_applied, const TimePoint& now,
                                       const PropertyTransition &defaultTransition) {
     auto style_it = styles.find(class_id);
     if (style_it == styles.end()) {
@@ -82,25 +159,28 @@ void StyleLayer::applyClassProperties(const ClassID class_id,
     const ClassProperties &class_properties = style_it->second;
     for (const auto& property_pair : class_properties) {
         PropertyKey key = property_pair.first;
-        if (already_applied.find(key) != already_applied.end()) {
+        const size_t index = static_cast<size_t>(key);
+        if (already_applied.test(index)) {
             // This property has already been set by a previous class.
             continue;
         }
 
         // Mark this property as written by a previous class, so that subsequent
         // classes won't override this.
-        already_applied.insert(key);
+        already_applied.set(index);
 
         // If the most recent transition is not the one with the highest priority, create
         // a transition.
-        AppliedClassPropertyValues &appliedProperties = appliedStyle[key];
-        if (appliedProperties.mostRecent() != class_id) {
+        AppliedClassPropertyValues &appliedProperties = appliedStyle[index];
+        if (appliedProperties.mostRecent() != class_id || changedKeys.test(index)) {
             const PropertyTransition &transition =
                 class_properties.getTransition(key, defaultTransition);
             const TimePoint begin = now + transition.delay;
             const TimePoint end = begin + transition.duration;
             const PropertyValue &value = property_pair.second;
             appliedProperties.add(class_id, begin, end, value);
+            appliedKeys.set(index);
+            transitioningKeys.set(index, appliedProperties.hasTransitions());
         }
     }
 }
@@ -116,7 +196,7 @@ struct PropertyEvaluator {
     }
 
     T operator()(const Function<T> &value) const {
-        return mapbox::util::apply_visitor(FunctionEvaluator<T>(z), value);
+        return evaluateFunction(value, z);
     }
 
     T operator()(const PiecewiseConstantFunction<T> &value) const {
@@ -135,12 +215,12 @@ private:
 
 template <typename T>
 void StyleLayer::applyStyleProperty(PropertyKey key, T &target, const float z, const TimePoint& now, const ZoomHistory &zoomHistory) {
-    auto it = appliedStyle.find(key);
-    if (it != appliedStyle.end()) {
-        AppliedClassPropertyValues &applied = it->second;
+    const size_t index = static_cast<size_t>(key);
+    if (appliedKeys.test(index)) {
+        const AppliedClassPropertyValues &applied = appliedStyle[index];
         // Iterate through all properties that we need to apply in order.
         const PropertyEvaluator<T> evaluator(z, zoomHistory);
-        for (auto& property : applied.propertyValues) {
+        for (const auto& property : applied.propertyValues) {
             if (now >= property.begin) {
                 // We overwrite the current property with the new value.
                 target = mapbox::util::apply_visitor(evaluator, property.value);
@@ -153,12 +233,12 @@ void StyleLayer::applyStyleProperty(PropertyKey key, T &target, const float z, c
 
 template <typename T>
 void StyleLayer::applyTransitionedStyleProperty(PropertyKey key, T &target, const float z, const TimePoint& now, const ZoomHistory &zoomHistory) {
-    auto it = appliedStyle.find(key);
-    if (it != appliedStyle.end()) {
-        AppliedClassPropertyValues &applied = it->second;
+    const size_t index = static_cast<size_t>(key);
+    if (appliedKeys.test(index)) {
+        const AppliedClassPropertyValues &applied = appliedStyle[index];
         // Iterate through all properties that we need to apply in order.
         const PropertyEvaluator<T> evaluator(z, zoomHistory);
-        for (auto& property : applied.propertyValues) {
+        for (const auto& property : applied.propertyValues) {
             if (now >= property.end) {
                 // We overwrite the current property with the new value.
                 target = mapbox::util::apply_visitor(evaluator, property.value);
@@ -260,23 +340,108 @@ void StyleLayer::updateProperties(float z, const TimePoint& now, ZoomHistory &zo
         case StyleLayerType::Background: applyStyleProperties<BackgroundProperties>(z, now, zoomHistory); break;
         default: properties.set<std::false_type>(); break;
     }
+
+    updateValidity(z, now, zoomHistory);
 }
 
-bool StyleLayer::hasTransitions() const {
-    for (const auto& pair : appliedStyle) {
-        if (pair.second.hasTransitions()) {
-            return true;
+namespace {
+
+// Determines the zoom levels around z at which a property value evaluates to the same result.
+struct ConstantRangeEvaluator {
+    typedef std::pair<float, float> result_type;
+
+    ConstantRangeEvaluator(float z_, const ZoomHistory &zoomHistory_, bool &fading_)
+        : z(z_), zoomHistory(zoomHistory_), fading(fading_) {}
+
+    template <typename T>
+    result_type operator()(const Function<T> &value) const {
+        return mapbox::util::apply_visitor(*this, value);
+    }
+
+    template <typename T>
+    result_type operator()(const StopsFunction<T> &value) const {
+        return value.getConstantRange(z);
+    }
+
+    template <typename T>
+    result_type operator()(const PiecewiseConstantFunction<T> &value) const {
+        if (value.isFading(zoomHistory)) {
+            fading = true;
+        }
+        return { z, z };
+    }
+
+    template <typename T>
+    result_type operator()(const T &) const {
+        return { -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+    }
+
+private:
+    const float z;
+    const ZoomHistory &zoomHistory;
+    bool &fading;
+};
+
+}
+
+void StyleLayer::updateValidity(const float z, const TimePoint& now, const ZoomHistory &zoomHistory) {
+    bool fading = false;
+    const ConstantRangeEvaluator evaluator(z, zoomHistory, fading);
+
+    minValidZoom = -std::numeric_limits<float>::infinity();
+    maxValidZoom = std::numeric_limits<float>::infinity();
+    timeDependent = false;
+
+    for (size_t index = 0; index < PropertyKeyCount; ++index) {
+        if (!appliedKeys.test(index)) {
+            continue;
+        }
+
+        for (const auto& property : appliedStyle[index].propertyValues) {
+            if (now < property.end) {
+                // Transitions that are in progress or haven't begun yet.
+                timeDependent = true;
+            }
+
+            const auto range = mapbox::util::apply_visitor(evaluator, property.value);
+            minValidZoom = std::max(minValidZoom, range.first);
+            maxValidZoom = std::min(maxValidZoom, range.second);
         }
     }
-    return false;
+
+    if (fading) {
+        timeDependent = true;
+    }
+
+    // The line width used for scaling dash arrays is evaluated at the integer zoom level.
+    if (type == StyleLayerType::Line) {
+        const float integerZoom = std::floor(z);
+        minValidZoom = std::max(minValidZoom, integerZoom);
+        maxValidZoom = std::min(maxValidZoom, std::nextafter(integerZoom + 1, integerZoom));
+    }
+}
+
+bool StyleLayer::needsUpdate(const float z) const {
+    return timeDependent || z < minValidZoom || z > maxValidZoom;
+}
+
+bool StyleLayer::hasTransitions() const {
+    return transitioningKeys.any();
 }
 
 void StyleLayer::cleanupAppliedStyleProperties(const TimePoint& now) {
-    for (auto it = appliedStyle.begin(); it != appliedStyle.end();) {
-        AppliedClassPropertyValues& values = it->second;
+    // Only properties with more than one value can have finished transitions to remove. A
+    // single value left is only removed if it is the fallback, which is never added alone.
+    for (size_t index = 0; index < PropertyKeyCount; ++index) {
+        if (!transitioningKeys.test(index)) {
+            continue;
+        }
+
+        AppliedClassPropertyValues& values = appliedStyle[index];
         values.cleanup(now);
-        // If the current properties object is empty, remove it from the map entirely.
-        values.empty() ? appliedStyle.erase(it++) : ++it;
+        transitioningKeys.set(index, values.hasTransitions());
+        // If the current properties object is empty, mark it as unused.
+        appliedKeys.set(index, !values.empty());
     }
 }
 
@@ -13,8 +13,10 @@
 
 #include <vector>
 #include <string>
+#include <limits>
 #include <map>
-#include <set>
+#include <array>
+#include <bitset>
 
 namespace mbgl {
 
@@ -42,15 +44,34 @@ public:
     // pending transitions and applied classes in order.
     void updateProperties(float z, const TimePoint& now, ZoomHistory &zoomHistory);
 
+    // Checks whether updateProperties could produce different values than the last time it was
+    // called, either because a zoom-dependent property crosses a stop or because a transition
+    // is in progress.
+    bool needsUpdate(float z) const;
+
     // Sets the list of classes and creates transitions to the currently applied values.
     void setClasses(const std::vector<std::string> &class_names, const TimePoint& now,
                     const PropertyTransition &defaultTransition);
 
+    // Same, with the class names already looked up. ClassDictionary is thread-local, so this
+    // is the one to use off the thread that parsed the style.
+    void setClassIDs(const std::vector<ClassID> &class_ids, const TimePoint& now,
+                     const PropertyTransition &defaultTransition);
+
     bool hasTransitions() const;
 
+    // Takes over the applied classes and transitions of the layer that this one replaces after
+    // the style was edited, so that unchanged properties don't transition again.
+    // Properties whose values changed are applied again by the next call to setClasses.
+    void inheritProperties(const StyleLayer &previous);
+
+    // Replaces the values and transitions of the given paint properties of a class. The new
+    // values are applied by the next call to setClasses.
+    void setPaintProperties(ClassID class_id, const ClassProperties &values);
+
 private:
     // Applies all properties from a class, if they haven't been applied already.
-    void applyClassProperties(ClassID class_id, std::set<PropertyKey> &already_applied,
+    void applyClassProperties(ClassID class_id, std::bitset<PropertyKeyCount> &already_applied,
                               const TimePoint& now, const PropertyTransition &defaultTransition);
 
     // Sets the properties of this object by evaluating all pending transitions and
@@ -62,6 +83,9 @@ private:
     // Removes all expired style transitions.
     void cleanupAppliedStyleProperties(const TimePoint& now);
 
+    // Determines the zoom levels at which the properties that were just evaluated stay the same.
+    void updateValidity(float z, const TimePoint& now, const ZoomHistory &zoomHistory);
+
 public:
     // The name of this layer.
     const std::string id;
@@ -73,12 +97,25 @@ public:
     util::ptr<const StyleBucket> bucket;
 
     // Contains all style classes that can be applied to this layer.
-    const std::map<ClassID, ClassProperties> styles;
+    std::map<ClassID, ClassProperties> styles;
 
 private:
     // For every property, stores a list of applied property values, with
-    // optional transition times.
-    std::map<PropertyKey, AppliedClassPropertyValues> appliedStyle;
+    // optional transition times. Indexed by PropertyKey; appliedKeys tells which entries have
+    // values, and transitioningKeys which of them have more than one.
+    std::array<AppliedClassPropertyValues, PropertyKeyCount> appliedStyle;
+    std::bitset<PropertyKeyCount> appliedKeys;
+    std::bitset<PropertyKeyCount> transitioningKeys;
+
+    // Keys whose values changed since they were applied; see inheritProperties and
+    // setPaintProperties.
+    std::bitset<PropertyKeyCount> changedKeys;
+
+    // The evaluated properties are valid for zoom levels in [minValidZoom, maxValidZoom], as long
+    // as they don't depend on the time. An empty range means they have to be evaluated.
+    float minValidZoom = std::numeric_limits<float>::infinity();
+    float maxValidZoom = -std::numeric_limits<float>::infinity();
+    bool timeDependent = false;
 
 public:
     // Stores the evaluated, and cascaded styling information, specific to this
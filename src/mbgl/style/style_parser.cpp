@@ -17,11 +17,65 @@
 #pragma GCC diagnostic pop
 
 #include <algorithm>
+#include <cstring>
 
 namespace mbgl {
 
 using JSVal = const rapidjson::Value&;
 
+namespace {
+
+// Property names are prefixed with the layer type they belong to. Scanning the member names once
+// tells which groups of properties an object can contain, so that the others don't have to be
+// looked up one by one.
+enum PropertyGroup : uint8_t {
+    FillGroup = 1 << 0,
+    LineGroup = 1 << 1,
+    SymbolGroup = 1 << 2,
+    IconGroup = 1 << 3,
+    TextGroup = 1 << 4,
+    RasterGroup = 1 << 5,
+    BackgroundGroup = 1 << 6,
+
+    // Set when a member is null. Looking up such a member gives the same null value as looking up
+    // one that doesn't exist, but it is a property with an invalid value.
+    NullMembers = 1 << 7,
+};
+
+uint8_t propertyGroups(JSVal value) {
+    static const std::pair<const char *, PropertyGroup> prefixes[] = {
+        { "fill-", FillGroup },
+        { "line-", LineGroup },
+        { "symbol-", SymbolGroup },
+        { "icon-", IconGroup },
+        { "text-", TextGroup },
+        { "raster-", RasterGroup },
+        { "background-", BackgroundGroup },
+    };
+
+    uint8_t groups = 0;
+    if (!value.IsObject()) {
+        return groups;
+    }
+
+    for (auto itr = value.MemberBegin(); itr != value.MemberEnd(); ++itr) {
+        if (itr->value.IsNull()) {
+            groups |= NullMembers;
+        }
+
+        const char *name = itr->name.GetString();
+        for (const auto& prefix : prefixes) {
+            if (std::strncmp(name, prefix.first, std::strlen(prefix.first)) == 0) {
+                groups |= prefix.second;
+                break;
+            }
+        }
+    }
+    return groups;
+}
+
+}
+
 StyleParser::StyleParser(MapData& data_)
     : data(data_) {
 }
@@ -43,7 +97,7 @@ void StyleParser::parse(JSVal document) {
 
         std::unique_ptr<Source> shapeAnnotationsSource = std::make_unique<Source>();
         shapeAnnotationsSource->info.type = SourceType::Annotations;
-        shapeAnnotationsSource->info.source_id = shapeID;
+        shapeAnnotationsSource->info.source_id = InternedString(shapeID);
         sourcesMap.emplace(shapeID, shapeAnnotationsSource.get());
         sources.emplace_back(std::move(shapeAnnotationsSource));
 
@@ -58,8 +112,8 @@ void StyleParser::parse(JSVal document) {
 
         // create point annotations symbol bucket
         util::ptr<StyleBucket> pointBucket = std::make_shared<StyleBucket>(pointAnnotationsLayer->type);
-        pointBucket->name = pointAnnotationsLayer->id;
-        pointBucket->source = pointID;
+        pointBucket->name = InternedString(pointAnnotationsLayer->id);
+        pointBucket->source = InternedString(pointID);
         pointBucket->source_layer = pointAnnotationsLayer->id;
 
         // build up point annotations style
@@ -74,7 +128,7 @@ void StyleParser::parse(JSVal document) {
         // create point annotations source & connect to bucket & layer
         std::unique_ptr<Source> pointAnnotationsSource = std::make_unique<Source>();
         pointAnnotationsSource->info.type = SourceType::Annotations;
-        pointAnnotationsSource->info.source_id = pointID;
+        pointAnnotationsSource->info.source_id = InternedString(pointID);
         pointAnnotationsLayer->bucket = pointBucket;
         sourcesMap.emplace(pointID, pointAnnotationsSource.get());
         sources.emplace_back(std::move(pointAnnotationsSource));
@@ -105,7 +159,8 @@ void StyleParser::parseConstants(JSVal value) {
 }
 
 JSVal StyleParser::replaceConstant(JSVal value) {
-    if (value.IsString()) {
+    // Constants start with an @ sign; don't build a key for all the other strings.
+    if (value.IsString() && value.GetStringLength() && value.GetString()[0] == '@') {
         auto it = constants.find({ value.GetString(), value.GetStringLength() });
         if (it != constants.end()) {
             return *it->second;
@@ -233,7 +288,7 @@ void StyleParser::parseSources(JSVal value) {
             parseRenderProperty<SourceTypeClass>(itr->value, source->info.type, "type");
             parseRenderProperty(itr->value, source->info.url, "url");
             parseRenderProperty(itr->value, source->info.tile_size, "tileSize");
-            source->info.source_id = name;
+            source->info.source_id = InternedString(name);
             source->info.parseTileJSONProperties(itr->value);
             sourcesMap.emplace(name, source.get());
             sources.emplace_back(std::move(source));
@@ -445,23 +500,27 @@ void StyleParser::parseVisibility(StyleBucket &bucket, JSVal value) {
 
 template<typename T>
 StyleParser::Status StyleParser::parseOptionalProperty(const char *property_name, PropertyKey key, ClassProperties &klass, JSVal value) {
-    if (!value.HasMember(property_name)) {
+    // Missing members are null; looking them up once is cheaper than HasMember() followed by [].
+    JSVal property = value[property_name];
+    if (property.IsNull() && !(nullMembers && value.HasMember(property_name))) {
         return StyleParserFailure;
     } else {
-        return setProperty<T>(replaceConstant(value[property_name]), property_name, key, klass);
+        return setProperty<T>(replaceConstant(property), property_name, key, klass);
     }
 }
 
 template<typename T>
 StyleParser::Status StyleParser::parseOptionalProperty(const char *property_name, PropertyKey key, ClassProperties &klass, JSVal value, const char *transition_name) {
-    if (!value.HasMember(property_name)) {
+    JSVal property = value[property_name];
+    if (property.IsNull() && !(nullMembers && value.HasMember(property_name))) {
         return StyleParserFailure;
     } else {
-        if (value.HasMember(transition_name)) {
-            return setProperty<T>(replaceConstant(value[property_name]), property_name, key, klass, value[transition_name]);
+        JSVal transition = value[transition_name];
+        if (!transition.IsNull()) {
+            return setProperty<T>(replaceConstant(property), property_name, key, klass, transition);
         } else {
             JSVal val = JSVal(rapidjson::kObjectType);
-            return setProperty<T>(replaceConstant(value[property_name]), property_name, key, klass, val);
+            return setProperty<T>(replaceConstant(property), property_name, key, klass, val);
         }
     }
 }
@@ -779,12 +838,16 @@ void StyleParser::parseLayer(std::pair<JSVal, util::ptr<StyleLayer>> &pair) {
 void StyleParser::parsePaints(JSVal value, std::map<ClassID, ClassProperties> &paints) {
     rapidjson::Value::ConstMemberIterator itr = value.MemberBegin();
     for (; itr != value.MemberEnd(); ++itr) {
-        const std::string name { itr->name.GetString(), itr->name.GetStringLength() };
+        const char *name = itr->name.GetString();
+        const rapidjson::SizeType length = itr->name.GetStringLength();
 
-        if (name == "paint") {
+        // Compare in place; most members of a layer aren't paint classes.
+        if (length < 5 || std::strncmp(name, "paint", 5) != 0) {
+            continue;
+        } else if (length == 5) {
             parsePaint(replaceConstant(itr->value), paints[ClassID::Default]);
-        } else if (name.compare(0, 6, "paint.") == 0 && name.length() > 6) {
-            const ClassID class_id = ClassDictionary::Get().lookup(name.substr(6));
+        } else if (name[5] == '.' && length > 6) {
+            const ClassID class_id = ClassDictionary::Get().lookup({ name + 6, length - 6 });
             parsePaint(replaceConstant(itr->value), paints[class_id]);
         }
     }
@@ -792,84 +855,98 @@ void StyleParser::parsePaints(JSVal value, std::map<ClassID, ClassProperties> &p
 
 void StyleParser::parsePaint(JSVal value, ClassProperties &klass) {
     using Key = PropertyKey;
-
-    parseOptionalProperty<Function<bool>>("fill-antialias", Key::FillAntialias, klass, value);
-    parseOptionalProperty<Function<float>>("fill-opacity", Key::FillOpacity, klass, value);
-    parseOptionalProperty<PropertyTransition>("fill-opacity-transition", Key::FillOpacity, klass, value);
-    parseOptionalProperty<Function<Color>>("fill-color", Key::FillColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("fill-color-transition", Key::FillColor, klass, value);
-    parseOptionalProperty<Function<Color>>("fill-outline-color", Key::FillOutlineColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("fill-outline-color-transition", Key::FillOutlineColor, klass, value);
-    parseOptionalProperty<Function<std::array<float, 2>>>("fill-translate", Key::FillTranslate, klass, value);
-    parseOptionalProperty<PropertyTransition>("fill-translate-transition", Key::FillTranslate, klass, value);
-    parseOptionalProperty<Function<TranslateAnchorType>>("fill-translate-anchor", Key::FillTranslateAnchor, klass, value);
-    parseOptionalProperty<PiecewiseConstantFunction<Faded<std::string>>>("fill-image", Key::FillImage, klass, value, "fill-image-transition");
-
-    parseOptionalProperty<Function<float>>("line-opacity", Key::LineOpacity, klass, value);
-    parseOptionalProperty<PropertyTransition>("line-opacity-transition", Key::LineOpacity, klass, value);
-    parseOptionalProperty<Function<Color>>("line-color", Key::LineColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("line-color-transition", Key::LineColor, klass, value);
-    parseOptionalProperty<Function<std::array<float,2>>>("line-translate", Key::LineTranslate, klass, value);
-    parseOptionalProperty<PropertyTransition>("line-translate-transition", Key::LineTranslate, klass, value);
-    parseOptionalProperty<Function<TranslateAnchorType>>("line-translate-anchor", Key::LineTranslateAnchor, klass, value);
-    parseOptionalProperty<Function<float>>("line-width", Key::LineWidth, klass, value);
-    parseOptionalProperty<PropertyTransition>("line-width-transition", Key::LineWidth, klass, value);
-    parseOptionalProperty<Function<float>>("line-gap-width", Key::LineGapWidth, klass, value);
-    parseOptionalProperty<PropertyTransition>("line-gap-width-transition", Key::LineGapWidth, klass, value);
-    parseOptionalProperty<Function<float>>("line-blur", Key::LineBlur, klass, value);
-    parseOptionalProperty<PropertyTransition>("line-blur-transition", Key::LineBlur, klass, value);
-    parseOptionalProperty<PiecewiseConstantFunction<Faded<std::vector<float>>>>("line-dasharray", Key::LineDashArray, klass, value, "line-dasharray-transition");
-    parseOptionalProperty<PiecewiseConstantFunction<Faded<std::string>>>("line-image", Key::LineImage, klass, value, "line-image-transition");
-
-    parseOptionalProperty<Function<float>>("icon-opacity", Key::IconOpacity, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-opacity-transition", Key::IconOpacity, klass, value);
-    parseOptionalProperty<Function<float>>("icon-size", Key::IconSize, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-size-transition", Key::IconSize, klass, value);
-    parseOptionalProperty<Function<Color>>("icon-color", Key::IconColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-color-transition", Key::IconColor, klass, value);
-    parseOptionalProperty<Function<Color>>("icon-halo-color", Key::IconHaloColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-halo-color-transition", Key::IconHaloColor, klass, value);
-    parseOptionalProperty<Function<float>>("icon-halo-width", Key::IconHaloWidth, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-halo-width-transition", Key::IconHaloWidth, klass, value);
-    parseOptionalProperty<Function<float>>("icon-halo-blur", Key::IconHaloBlur, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-halo-blur-transition", Key::IconHaloBlur, klass, value);
-    parseOptionalProperty<Function<std::array<float, 2>>>("icon-translate", Key::IconTranslate, klass, value);
-    parseOptionalProperty<PropertyTransition>("icon-translate-transition", Key::IconTranslate, klass, value);
-    parseOptionalProperty<Function<TranslateAnchorType>>("icon-translate-anchor", Key::IconTranslateAnchor, klass, value);
-
-    parseOptionalProperty<Function<float>>("text-opacity", Key::TextOpacity, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-opacity-transition", Key::TextOpacity, klass, value);
-    parseOptionalProperty<Function<float>>("text-size", Key::TextSize, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-size-transition", Key::TextSize, klass, value);
-    parseOptionalProperty<Function<Color>>("text-color", Key::TextColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-color-transition", Key::TextColor, klass, value);
-    parseOptionalProperty<Function<Color>>("text-halo-color", Key::TextHaloColor, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-halo-color-transition", Key::TextHaloColor, klass, value);
-    parseOptionalProperty<Function<float>>("text-halo-width", Key::TextHaloWidth, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-halo-width-transition", Key::TextHaloWidth, klass, value);
-    parseOptionalProperty<Function<float>>("text-halo-blur", Key::TextHaloBlur, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-halo-blur-transition", Key::TextHaloBlur, klass, value);
-    parseOptionalProperty<Function<std::array<float, 2>>>("text-translate", Key::TextTranslate, klass, value);
-    parseOptionalProperty<PropertyTransition>("text-translate-transition", Key::TextTranslate, klass, value);
-    parseOptionalProperty<Function<TranslateAnchorType>>("text-translate-anchor", Key::TextTranslateAnchor, klass, value);
-
-    parseOptionalProperty<Function<float>>("raster-opacity", Key::RasterOpacity, klass, value);
-    parseOptionalProperty<PropertyTransition>("raster-opacity-transition", Key::RasterOpacity, klass, value);
-    parseOptionalProperty<Function<float>>("raster-hue-rotate", Key::RasterHueRotate, klass, value);
-    parseOptionalProperty<PropertyTransition>("raster-hue-rotate-transition", Key::RasterHueRotate, klass, value);
-    parseOptionalProperty<Function<float>>("raster-brightness-min", Key::RasterBrightnessLow, klass, value);
-    parseOptionalProperty<Function<float>>("raster-brightness-max", Key::RasterBrightnessHigh, klass, value);
-    parseOptionalProperty<PropertyTransition>("raster-brightness-transition", Key::RasterBrightness, klass, value);
-    parseOptionalProperty<Function<float>>("raster-saturation", Key::RasterSaturation, klass, value);
-    parseOptionalProperty<PropertyTransition>("raster-saturation-transition", Key::RasterSaturation, klass, value);
-    parseOptionalProperty<Function<float>>("raster-contrast", Key::RasterContrast, klass, value);
-    parseOptionalProperty<PropertyTransition>("raster-contrast-transition", Key::RasterContrast, klass, value);
-    parseOptionalProperty<Function<float>>("raster-fade-duration", Key::RasterFade, klass, value);
-    parseOptionalProperty<PropertyTransition>("raster-fade-duration-transition", Key::RasterFade, klass, value);
-
-    parseOptionalProperty<Function<float>>("background-opacity", Key::BackgroundOpacity, klass, value);
-    parseOptionalProperty<Function<Color>>("background-color", Key::BackgroundColor, klass, value);
-    parseOptionalProperty<PiecewiseConstantFunction<Faded<std::string>>>("background-image", Key::BackgroundImage, klass, value, "background-image-transition");
+    const uint8_t groups = propertyGroups(value);
+    nullMembers = groups & NullMembers;
+
+    if (groups & FillGroup) {
+        parseOptionalProperty<Function<bool>>("fill-antialias", Key::FillAntialias, klass, value);
+        parseOptionalProperty<Function<float>>("fill-opacity", Key::FillOpacity, klass, value);
+        parseOptionalProperty<PropertyTransition>("fill-opacity-transition", Key::FillOpacity, klass, value);
+        parseOptionalProperty<Function<Color>>("fill-color", Key::FillColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("fill-color-transition", Key::FillColor, klass, value);
+        parseOptionalProperty<Function<Color>>("fill-outline-color", Key::FillOutlineColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("fill-outline-color-transition", Key::FillOutlineColor, klass, value);
+        parseOptionalProperty<Function<std::array<float, 2>>>("fill-translate", Key::FillTranslate, klass, value);
+        parseOptionalProperty<PropertyTransition>("fill-translate-transition", Key::FillTranslate, klass, value);
+        parseOptionalProperty<Function<TranslateAnchorType>>("fill-translate-anchor", Key::FillTranslateAnchor, klass, value);
+        parseOptionalProperty<PiecewiseConstantFunction<Faded<std::string>>>("fill-image", Key::FillImage, klass, value, "fill-image-transition");
+    }
+
+    if (groups & LineGroup) {
+        parseOptionalProperty<Function<float>>("line-opacity", Key::LineOpacity, klass, value);
+        parseOptionalProperty<PropertyTransition>("line-opacity-transition", Key::LineOpacity, klass, value);
+        parseOptionalProperty<Function<Color>>("line-color", Key::LineColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("line-color-transition", Key::LineColor, klass, value);
+        parseOptionalProperty<Function<std::array<float,2>>>("line-translate", Key::LineTranslate, klass, value);
+        parseOptionalProperty<PropertyTransition>("line-translate-transition", Key::LineTranslate, klass, value);
+        parseOptionalProperty<Function<TranslateAnchorType>>("line-translate-anchor", Key::LineTranslateAnchor, klass, value);
+        parseOptionalProperty<Function<float>>("line-width", Key::LineWidth, klass, value);
+        parseOptionalProperty<PropertyTransition>("line-width-transition", Key::LineWidth, klass, value);
+        parseOptionalProperty<Function<float>>("line-gap-width", Key::LineGapWidth, klass, value);
+        parseOptionalProperty<PropertyTransition>("line-gap-width-transition", Key::LineGapWidth, klass, value);
+        parseOptionalProperty<Function<float>>("line-blur", Key::LineBlur, klass, value);
+        parseOptionalProperty<PropertyTransition>("line-blur-transition", Key::LineBlur, klass, value);
+        parseOptionalProperty<PiecewiseConstantFunction<Faded<std::vector<float>>>>("line-dasharray", Key::LineDashArray, klass, value, "line-dasharray-transition");
+        parseOptionalProperty<PiecewiseConstantFunction<Faded<std::string>>>("line-image", Key::LineImage, klass, value, "line-image-transition");
+    }
+
+    if (groups & IconGroup) {
+        parseOptionalProperty<Function<float>>("icon-opacity", Key::IconOpacity, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-opacity-transition", Key::IconOpacity, klass, value);
+        parseOptionalProperty<Function<float>>("icon-size", Key::IconSize, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-size-transition", Key::IconSize, klass, value);
+        parseOptionalProperty<Function<Color>>("icon-color", Key::IconColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-color-transition", Key::IconColor, klass, value);
+        parseOptionalProperty<Function<Color>>("icon-halo-color", Key::IconHaloColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-halo-color-transition", Key::IconHaloColor, klass, value);
+        parseOptionalProperty<Function<float>>("icon-halo-width", Key::IconHaloWidth, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-halo-width-transition", Key::IconHaloWidth, klass, value);
+        parseOptionalProperty<Function<float>>("icon-halo-blur", Key::IconHaloBlur, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-halo-blur-transition", Key::IconHaloBlur, klass, value);
+        parseOptionalProperty<Function<std::array<float, 2>>>("icon-translate", Key::IconTranslate, klass, value);
+        parseOptionalProperty<PropertyTransition>("icon-translate-transition", Key::IconTranslate, klass, value);
+        parseOptionalProperty<Function<TranslateAnchorType>>("icon-translate-anchor", Key::IconTranslateAnchor, klass, value);
+    }
+
+    if (groups & TextGroup) {
+        parseOptionalProperty<Function<float>>("text-opacity", Key::TextOpacity, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-opacity-transition", Key::TextOpacity, klass, value);
+        parseOptionalProperty<Function<float>>("text-size", Key::TextSize, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-size-transition", Key::TextSize, klass, value);
+        parseOptionalProperty<Function<Color>>("text-color", Key::TextColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-color-transition", Key::TextColor, klass, value);
+        parseOptionalProperty<Function<Color>>("text-halo-color", Key::TextHaloColor, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-halo-color-transition", Key::TextHaloColor, klass, value);
+        parseOptionalProperty<Function<float>>("text-halo-width", Key::TextHaloWidth, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-halo-width-transition", Key::TextHaloWidth, klass, value);
+        parseOptionalProperty<Function<float>>("text-halo-blur", Key::TextHaloBlur, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-halo-blur-transition", Key::TextHaloBlur, klass, value);
+        parseOptionalProperty<Function<std::array<float, 2>>>("text-translate", Key::TextTranslate, klass, value);
+        parseOptionalProperty<PropertyTransition>("text-translate-transition", Key::TextTranslate, klass, value);
+        parseOptionalProperty<Function<TranslateAnchorType>>("text-translate-anchor", Key::TextTranslateAnchor, klass, value);
+    }
+
+    if (groups & RasterGroup) {
+        parseOptionalProperty<Function<float>>("raster-opacity", Key::RasterOpacity, klass, value);
+        parseOptionalProperty<PropertyTransition>("raster-opacity-transition", Key::RasterOpacity, klass, value);
+        parseOptionalProperty<Function<float>>("raster-hue-rotate", Key::RasterHueRotate, klass, value);
+        parseOptionalProperty<PropertyTransition>("raster-hue-rotate-transition", Key::RasterHueRotate, klass, value);
+        parseOptionalProperty<Function<float>>("raster-brightness-min", Key::RasterBrightnessLow, klass, value);
+        parseOptionalProperty<Function<float>>("raster-brightness-max", Key::RasterBrightnessHigh, klass, value);
+        parseOptionalProperty<PropertyTransition>("raster-brightness-transition", Key::RasterBrightness, klass, value);
+        parseOptionalProperty<Function<float>>("raster-saturation", Key::RasterSaturation, klass, value);
+        parseOptionalProperty<PropertyTransition>("raster-saturation-transition", Key::RasterSaturation, klass, value);
+        parseOptionalProperty<Function<float>>("raster-contrast", Key::RasterContrast, klass, value);
+        parseOptionalProperty<PropertyTransition>("raster-contrast-transition", Key::RasterContrast, klass, value);
+        parseOptionalProperty<Function<float>>("raster-fade-duration", Key::RasterFade, klass, value);
+        parseOptionalProperty<PropertyTransition>("raster-fade-duration-transition", Key::RasterFade, klass, value);
+    }
+
+    if (groups & BackgroundGroup) {
+        parseOptionalProperty<Function<float>>("background-opacity", Key::BackgroundOpacity, klass, value);
+        parseOptionalProperty<Function<Color>>("background-color", Key::BackgroundColor, klass, value);
+        parseOptionalProperty<PiecewiseConstantFunction<Faded<std::string>>>("background-image", Key::BackgroundImage, klass, value, "background-image-transition");
+    }
 }
 
 void StyleParser::parseLayout(JSVal value, util::ptr<StyleBucket> &bucket) {
@@ -877,43 +954,55 @@ void StyleParser::parseLayout(JSVal value, util::ptr<StyleBucket> &bucket) {
 
     parseVisibility<VisibilityType>(*bucket, value);
 
-    parseOptionalProperty<Function<CapType>>("line-cap", Key::LineCap, bucket->layout, value);
-    parseOptionalProperty<Function<JoinType>>("line-join", Key::LineJoin, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("line-miter-limit", Key::LineMiterLimit, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("line-round-limit", Key::LineRoundLimit, bucket->layout, value);
-
-    parseOptionalProperty<Function<PlacementType>>("symbol-placement", Key::SymbolPlacement, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("symbol-min-distance", Key::SymbolMinDistance, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("symbol-avoid-edges", Key::SymbolAvoidEdges, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("icon-allow-overlap", Key::IconAllowOverlap, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("icon-ignore-placement", Key::IconIgnorePlacement, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("icon-optional", Key::IconOptional, bucket->layout, value);
-    parseOptionalProperty<Function<RotationAlignmentType>>("icon-rotation-alignment", Key::IconRotationAlignment, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("icon-max-size", Key::IconMaxSize, bucket->layout, value);
-    parseOptionalProperty<Function<std::string>>("icon-image", Key::IconImage, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("icon-rotate", Key::IconRotate, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("icon-padding", Key::IconPadding, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("icon-keep-upright", Key::IconKeepUpright, bucket->layout, value);
-    parseOptionalProperty<Function<std::array<float, 2>>>("icon-offset", Key::IconOffset, bucket->layout, value);
-    parseOptionalProperty<Function<RotationAlignmentType>>("text-rotation-alignment", Key::TextRotationAlignment, bucket->layout, value);
-    parseOptionalProperty<Function<std::string>>("text-field", Key::TextField, bucket->layout, value);
-    parseOptionalProperty<Function<std::string>>("text-font", Key::TextFont, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-max-size", Key::TextMaxSize, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-max-width", Key::TextMaxWidth, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-line-height", Key::TextLineHeight, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-letter-spacing", Key::TextLetterSpacing, bucket->layout, value);
-    parseOptionalProperty<Function<TextJustifyType>>("text-justify", Key::TextJustify, bucket->layout, value);
-    parseOptionalProperty<Function<TextAnchorType>>("text-anchor", Key::TextAnchor, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-max-angle", Key::TextMaxAngle, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-rotate", Key::TextRotate, bucket->layout, value);
-    parseOptionalProperty<Function<float>>("text-padding", Key::TextPadding, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("text-keep-upright", Key::TextKeepUpright, bucket->layout, value);
-    parseOptionalProperty<Function<TextTransformType>>("text-transform", Key::TextTransform, bucket->layout, value);
-    parseOptionalProperty<Function<std::array<float, 2>>>("text-offset", Key::TextOffset, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("text-allow-overlap", Key::TextAllowOverlap, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("text-ignore-placement", Key::TextIgnorePlacement, bucket->layout, value);
-    parseOptionalProperty<Function<bool>>("text-optional", Key::TextOptional, bucket->layout, value);
-
+    const uint8_t groups = propertyGroups(value);
+    nullMembers = groups & NullMembers;
+
+    if (groups & LineGroup) {
+        parseOptionalProperty<Function<CapType>>("line-cap", Key::LineCap, bucket->layout, value);
+        parseOptionalProperty<Function<JoinType>>("line-join", Key::LineJoin, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("line-miter-limit", Key::LineMiterLimit, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("line-round-limit", Key::LineRoundLimit, bucket->layout, value);
+    }
+
+    if (groups & SymbolGroup) {
+        parseOptionalProperty<Function<PlacementType>>("symbol-placement", Key::SymbolPlacement, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("symbol-min-distance", Key::SymbolMinDistance, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("symbol-avoid-edges", Key::SymbolAvoidEdges, bucket->layout, value);
+    }
+
+    if (groups & IconGroup) {
+        parseOptionalProperty<Function<bool>>("icon-allow-overlap", Key::IconAllowOverlap, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("icon-ignore-placement", Key::IconIgnorePlacement, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("icon-optional", Key::IconOptional, bucket->layout, value);
+        parseOptionalProperty<Function<RotationAlignmentType>>("icon-rotation-alignment", Key::IconRotationAlignment, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("icon-max-size", Key::IconMaxSize, bucket->layout, value);
+        parseOptionalProperty<Function<std::string>>("icon-image", Key::IconImage, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("icon-rotate", Key::IconRotate, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("icon-padding", Key::IconPadding, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("icon-keep-upright", Key::IconKeepUpright, bucket->layout, value);
+        parseOptionalProperty<Function<std::array<float, 2>>>("icon-offset", Key::IconOffset, bucket->layout, value);
+    }
+
+    if (groups & TextGroup) {
+        parseOptionalProperty<Function<RotationAlignmentType>>("text-rotation-alignment", Key::TextRotationAlignment, bucket->layout, value);
+        parseOptionalProperty<Function<std::string>>("text-field", Key::TextField, bucket->layout, value);
+        parseOptionalProperty<Function<std::string>>("text-font", Key::TextFont, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-max-size", Key::TextMaxSize, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-max-width", Key::TextMaxWidth, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-line-height", Key::TextLineHeight, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-letter-spacing", Key::TextLetterSpacing, bucket->layout, value);
+        parseOptionalProperty<Function<TextJustifyType>>("text-justify", Key::TextJustify, bucket->layout, value);
+        parseOptionalProperty<Function<TextAnchorType>>("text-anchor", Key::TextAnchor, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-max-angle", Key::TextMaxAngle, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-rotate", Key::TextRotate, bucket->layout, value);
+        parseOptionalProperty<Function<float>>("text-padding", Key::TextPadding, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("text-keep-upright", Key::TextKeepUpright, bucket->layout, value);
+        parseOptionalProperty<Function<TextTransformType>>("text-transform", Key::TextTransform, bucket->layout, value);
+        parseOptionalProperty<Function<std::array<float, 2>>>("text-offset", Key::TextOffset, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("text-allow-overlap", Key::TextAllowOverlap, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("text-ignore-placement", Key::TextIgnorePlacement, bucket->layout, value);
+        parseOptionalProperty<Function<bool>>("text-optional", Key::TextOptional, bucket->layout, value);
+    }
 }
 
 void StyleParser::parseReference(JSVal value, util::ptr<StyleLayer> &layer) {
@@ -945,12 +1034,12 @@ void StyleParser::parseBucket(JSVal value, util::ptr<StyleLayer> &layer) {
     util::ptr<StyleBucket> bucket = std::make_shared<StyleBucket>(layer->type);
 
     // We name the buckets according to the layer that defined it.
-    bucket->name = layer->id;
+    bucket->name = InternedString(layer->id);
 
     if (value.HasMember("source")) {
         JSVal value_source = replaceConstant(value["source"]);
         if (value_source.IsString()) {
-            bucket->source = { value_source.GetString(), value_source.GetStringLength() };
+            bucket->source = InternedString({ value_source.GetString(), value_source.GetStringLength() });
             auto source_it = sourcesMap.find(bucket->source);
             if (source_it == sourcesMap.end()) {
                 Log::Warning(Event::ParseStyle, "can't find source '%s' required for layer '%s'", bucket->source.c_str(), layer->id.c_str());
@@ -51,6 +51,10 @@ public:
         return glyph_url;
     }
 
+    // Parses the paint or layout properties of an object, e.g. to change a layer at runtime.
+    void parsePaint(JSVal, ClassProperties &properties);
+    void parseLayout(JSVal value, util::ptr<StyleBucket> &bucket);
+
 private:
     void parseConstants(JSVal value);
     JSVal replaceConstant(JSVal value);
@@ -59,10 +63,8 @@ private:
     void parseLayers(JSVal value);
     void parseLayer(std::pair<JSVal, util::ptr<StyleLayer>> &pair);
     void parsePaints(JSVal value, std::map<ClassID, ClassProperties> &paints);
-    void parsePaint(JSVal, ClassProperties &properties);
     void parseReference(JSVal value, util::ptr<StyleLayer> &layer);
     void parseBucket(JSVal value, util::ptr<StyleLayer> &layer);
-    void parseLayout(JSVal value, util::ptr<StyleBucket> &bucket);
     void parseSprite(JSVal value);
     void parseGlyphURL(JSVal value);
 
@@ -118,6 +120,9 @@ private:
     // URL template for glyph PBFs.
     std::string glyph_url;
 
+    // Whether the paint or layout object that is being parsed has members that are null.
+    bool nullMembers = false;
+
     // Obtain default transition duration from map data.
     MapData& data;
 };
@@ -1,10 +1,23 @@
 #include <mbgl/text/collision_tile.hpp>
 #include <cmath>
+#include <limits>
 
 namespace mbgl {
 
+const uint32_t CollisionTile::gridSize;
+
 void CollisionTile::reset(const float _angle, const float pitch) {
-    tree.clear();
+    entries.clear();
+    visited.clear();
+    if (++generation == 0) {
+        // The counter wrapped around; make sure no stale cell looks current.
+        for (auto& cell : cells) {
+            cell.generation = 0;
+            cell.entries.clear();
+        }
+        generation = 1;
+    }
+
     angle = _angle;
 
      // Compute the transformation matrix.
@@ -18,6 +31,23 @@ void CollisionTile::reset(const float _angle, const float pitch) {
     // The amount the map is squished depends on the y position.
     // Sort of account for this by making all boxes a bit bigger.
     yStretch = std::pow(_yStretch, 1.3);
+
+    // Fit the grid to the bounding box of the rotated tile.
+    float minX = std::numeric_limits<float>::infinity(), maxX = -minX;
+    float minY = minX, maxY = -minX;
+    for (const auto& corner : { vec2<float>(0, 0), vec2<float>(extent, 0),
+                                vec2<float>(0, extent), vec2<float>(extent, extent) }) {
+        const auto rotated = corner.matMul(rotationMatrix);
+        minX = std::fmin(minX, rotated.x);
+        maxX = std::fmax(maxX, rotated.x);
+        minY = std::fmin(minY, rotated.y);
+        maxY = std::fmax(maxY, rotated.y);
+    }
+
+    gridX = minX;
+    gridY = minY;
+    cellScaleX = gridSize / std::fmax(maxX - minX, 1.0f);
+    cellScaleY = gridSize / std::fmax(maxY - minY, 1.0f);
 }
 
 float CollisionTile::placeFeature(const CollisionFeature &feature) {
@@ -25,49 +55,69 @@ float CollisionTile::placeFeature(const CollisionFeature &feature) {
     float minPlacementScale = minScale;
 
     for (auto& box : feature.boxes) {
-        const auto anchor = box.anchor.matMul(rotationMatrix);
+        const Entry query = makeEntry(box.anchor.matMul(rotationMatrix), box);
+        const auto& anchor = query.anchor;
 
-        std::vector<CollisionTreeBox> blockingBoxes;
-        tree.query(bgi::intersects(getTreeBox(anchor, box)), std::back_inserter(blockingBoxes));
+        if (++queryID == 0) {
+            std::fill(visited.begin(), visited.end(), 0);
+            queryID = 1;
+        }
 
-        for (auto& blockingTreeBox : blockingBoxes) {
-            const auto& blocking = std::get<1>(blockingTreeBox);
-            auto blockingAnchor = blocking.anchor.matMul(rotationMatrix);
+        uint32_t cx1, cy1, cx2, cy2;
+        getCellRange(query, cx1, cy1, cx2, cy2);
 
-            // Find the lowest scale at which the two boxes can fit side by side without overlapping.
-            // Original algorithm:
-            float s1 = (blocking.x1 - box.x2) / (anchor.x - blockingAnchor.x); // scale at which new box is to the left of old box
-            float s2 = (blocking.x2 - box.x1) / (anchor.x - blockingAnchor.x); // scale at which new box is to the right of old box
-            float s3 = (blocking.y1 - box.y2) * yStretch / (anchor.y - blockingAnchor.y); // scale at which new box is to the top of old box
-            float s4 = (blocking.y2 - box.y1) * yStretch / (anchor.y - blockingAnchor.y); // scale at which new box is to the bottom of old box
+        for (uint32_t cy = cy1; cy <= cy2; ++cy) {
+        for (uint32_t cx = cx1; cx <= cx2; ++cx) {
+            const Cell& cell = cells[cy * gridSize + cx];
+            if (cell.generation != generation) continue;
 
-            if (std::isnan(s1) || std::isnan(s2)) s1 = s2 = 1;
-            if (std::isnan(s3) || std::isnan(s4)) s3 = s4 = 1;
+            for (const uint32_t index : cell.entries) {
+                if (visited[index] == queryID) continue;
+                visited[index] = queryID;
 
-            float collisionFreeScale = std::fmin(std::fmax(s1, s2), std::fmax(s3, s4));
+                const Entry& entry = entries[index];
+                if (entry.x1 > query.x2 || query.x1 > entry.x2 ||
+                    entry.y1 > query.y2 || query.y1 > entry.y2) continue;
 
-            if (collisionFreeScale > blocking.maxScale) {
-                // After a box's maxScale the label has shrunk enough that the box is no longer needed to cover it,
-                // so unblock the new box at the scale that the old box disappears.
-                collisionFreeScale = blocking.maxScale;
-            }
+                const auto& blocking = entry.box;
+                const auto& blockingAnchor = entry.anchor;
 
-            if (collisionFreeScale > box.maxScale) {
-                // If the box can only be shown after it is visible, then the box can never be shown.
-                // But the label can be shown after this box is not visible.
-                collisionFreeScale = box.maxScale;
-            }
+                // Find the lowest scale at which the two boxes can fit side by side without overlapping.
+                // Original algorithm:
+                float s1 = (blocking.x1 - box.x2) / (anchor.x - blockingAnchor.x); // scale at which new box is to the left of old box
+                float s2 = (blocking.x2 - box.x1) / (anchor.x - blockingAnchor.x); // scale at which new box is to the right of old box
+                float s3 = (blocking.y1 - box.y2) * yStretch / (anchor.y - blockingAnchor.y); // scale at which new box is to the top of old box
+                float s4 = (blocking.y2 - box.y1) * yStretch / (anchor.y - blockingAnchor.y); // scale at which new box is to the bottom of old box
 
-            if (collisionFreeScale > minPlacementScale &&
-                    collisionFreeScale >= blocking.placementScale) {
-                // If this collision occurs at a lower scale than previously found collisions
-                // and the collision occurs while the other label is visible
+                if (std::isnan(s1) || std::isnan(s2)) s1 = s2 = 1;
+                if (std::isnan(s3) || std::isnan(s4)) s3 = s4 = 1;
 
-                // this this is the lowest scale at which the label won't collide with anything
-                minPlacementScale = collisionFreeScale;
-            }
+                float collisionFreeScale = std::fmin(std::fmax(s1, s2), std::fmax(s3, s4));
+
+                if (collisionFreeScale > blocking.maxScale) {
+                    // After a box's maxScale the label has shrunk enough that the box is no longer needed to cover it,
+                    // so unblock the new box at the scale that the old box disappears.
+                    collisionFreeScale = blocking.maxScale;
+                }
 
-            if (minPlacementScale >= maxScale) return minPlacementScale;
+                if (collisionFreeScale > box.maxScale) {
+                    // If the box can only be shown after it is visible, then the box can never be shown.
+                    // But the label can be shown after this box is not visible.
+                    collisionFreeScale = box.maxScale;
+                }
+
+                if (collisionFreeScale > minPlacementScale &&
+                        collisionFreeScale >= blocking.placementScale) {
+                    // If this collision occurs at a lower scale than previously found collisions
+                    // and the collision occurs while the other label is visible
+
+                    // this this is the lowest scale at which the label won't collide with anything
+                    minPlacementScale = collisionFreeScale;
+                }
+
+                if (minPlacementScale >= maxScale) return minPlacementScale;
+            }
+        }
         }
     }
 
@@ -80,26 +130,50 @@ void CollisionTile::insertFeature(CollisionFeature &feature, const float minPlac
     }
 
     if (minPlacementScale < maxScale) {
-        std::vector<CollisionTreeBox> treeBoxes;
         for (auto& box : feature.boxes) {
-            treeBoxes.emplace_back(getTreeBox(box.anchor.matMul(rotationMatrix), box), box);
+            const auto index = static_cast<uint32_t>(entries.size());
+            entries.push_back(makeEntry(box.anchor.matMul(rotationMatrix), box));
+            visited.push_back(0);
+
+            uint32_t cx1, cy1, cx2, cy2;
+            getCellRange(entries.back(), cx1, cy1, cx2, cy2);
+
+            for (uint32_t cy = cy1; cy <= cy2; ++cy) {
+                for (uint32_t cx = cx1; cx <= cx2; ++cx) {
+                    Cell& cell = cells[cy * gridSize + cx];
+                    if (cell.generation != generation) {
+                        cell.generation = generation;
+                        cell.entries.clear();
+                    }
+                    cell.entries.push_back(index);
+                }
+            }
         }
-        tree.insert(treeBoxes.begin(), treeBoxes.end());
     }
 
 }
 
-Box CollisionTile::getTreeBox(const vec2<float> &anchor, const CollisionBox &box) {
-    return Box{
-        CollisionPoint{
-            anchor.x + box.x1,
-            anchor.y + box.y1 * yStretch
-        },
-        CollisionPoint{
-            anchor.x + box.x2,
-            anchor.y + box.y2 * yStretch
-        }
+CollisionTile::Entry CollisionTile::makeEntry(const vec2<float> &anchor, const CollisionBox &box) const {
+    return Entry{
+        box,
+        anchor,
+        anchor.x + box.x1,
+        anchor.y + box.y1 * yStretch,
+        anchor.x + box.x2,
+        anchor.y + box.y2 * yStretch
     };
 }
 
+static inline uint32_t clampCell(float position, uint32_t gridSize) {
+    // fmax/fmin also map NaN to a valid cell.
+    return static_cast<uint32_t>(std::fmax(0.0f, std::fmin(gridSize - 1.0f, std::floor(position))));
+}
+
+void CollisionTile::getCellRange(const Entry& entry, uint32_t& cx1, uint32_t& cy1, uint32_t& cx2, uint32_t& cy2) const {
+    cx1 = clampCell((entry.x1 - gridX) * cellScaleX, gridSize);
+    cy1 = clampCell((entry.y1 - gridY) * cellScaleY, gridSize);
+    cx2 = clampCell((entry.x2 - gridX) * cellScaleX, gridSize);
+    cy2 = clampCell((entry.y2 - gridY) * cellScaleY, gridSize);
+}
+
 }
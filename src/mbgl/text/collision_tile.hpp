@@ -3,40 +3,20 @@
 
 #include <mbgl/text/collision_feature.hpp>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wunused-variable"
-#pragma GCC diagnostic ignored "-Wshadow"
-#ifdef __clang__
-#pragma GCC diagnostic ignored "-Wunknown-pragmas"
-#endif
-#pragma GCC diagnostic ignored "-Wpragmas"
-#pragma GCC diagnostic ignored "-Wdeprecated-register"
-#pragma GCC diagnostic ignored "-Wshorten-64-to-32"
-#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#pragma GCC diagnostic pop
+#include <array>
+#include <vector>
+#include <cstdint>
 
 namespace mbgl {
 
-    namespace bg = boost::geometry;
-    namespace bgm = bg::model;
-    namespace bgi = bg::index;
-    typedef bgm::point<float, 2, bg::cs::cartesian> CollisionPoint;
-    typedef bgm::box<CollisionPoint> Box;
-    typedef std::pair<Box, CollisionBox> CollisionTreeBox;
-    typedef bgi::rtree<CollisionTreeBox, bgi::linear<16,4>> Tree;
-
 class CollisionTile {
 
     public:
     inline explicit CollisionTile(float _zoom, float tileExtent, float tileSize, float angle_, bool debug_) :
-        zoom(_zoom), tilePixelRatio(tileExtent / tileSize), debug(debug_) { reset(angle_, 0); }
+        zoom(_zoom), tilePixelRatio(tileExtent / tileSize), extent(tileExtent), debug(debug_) {
+        cells.resize(gridSize * gridSize);
+        reset(angle_, 0);
+    }
 
     void reset(const float angle, const float pitch);
     float placeFeature(const CollisionFeature &feature);
@@ -54,9 +34,41 @@ class CollisionTile {
 
     private:
 
-    Box getTreeBox(const vec2<float> &anchor, const CollisionBox &box);
+    // Placed boxes are indexed in a uniform grid that covers the rotated tile. Boxes that
+    // extend beyond the tile are clamped into the border cells, so no box is ever missed.
+    static const uint32_t gridSize = 32;
+
+    struct Entry {
+        CollisionBox box;
+        vec2<float> anchor; // rotated anchor
+        float x1, y1, x2, y2; // rotated and stretched bounds
+    };
+
+    struct Cell {
+        // The cell's contents are only valid if this matches the tile's generation, which lets
+        // reset() discard the whole grid in constant time while keeping the allocated memory.
+        uint32_t generation = 0;
+        std::vector<uint32_t> entries;
+    };
+
+    Entry makeEntry(const vec2<float> &anchor, const CollisionBox &box) const;
+    void getCellRange(const Entry&, uint32_t& cx1, uint32_t& cy1, uint32_t& cx2, uint32_t& cy2) const;
+
+    std::vector<Entry> entries;
+    std::vector<Cell> cells;
+    uint32_t generation = 0;
+
+    // Entries that were already tested during the current query are marked with its ID, so
+    // that boxes covering several cells are only tested once.
+    std::vector<uint32_t> visited;
+    uint32_t queryID = 0;
+
+    float gridX = 0;
+    float gridY = 0;
+    float cellScaleX = 0;
+    float cellScaleY = 0;
 
-    Tree tree;
+    const float extent;
     std::array<float, 4> rotationMatrix;
     float yStretch;
     bool debug;
@@ -0,0 +1,200 @@
+#include <mbgl/text/cross_tile_placement.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/renderer/symbol_bucket.hpp>
+#include <mbgl/map/transform_state.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+namespace mbgl {
+
+const int32_t CrossTilePlacement::cellSize;
+const int32_t CrossTilePlacement::margin;
+
+void CrossTilePlacement::beginFrame(const TransformState& state, const TimePoint& now, const Duration& fadeDuration) {
+    width = state.getWidth();
+    height = state.getHeight();
+    zoom = state.getNormalizedZoom();
+
+    const int32_t newGridWidth = (width + 2 * margin + cellSize - 1) / cellSize;
+    const int32_t newGridHeight = (height + 2 * margin + cellSize - 1) / cellSize;
+    if (newGridWidth != gridWidth || newGridHeight != gridHeight) {
+        gridWidth = newGridWidth;
+        gridHeight = newGridHeight;
+        cells.clear();
+        cells.resize(gridWidth * gridHeight);
+    }
+
+    entries.clear();
+    visited.clear();
+    if (++generation == 0) {
+        for (auto& cell : cells) {
+            cell.generation = 0;
+            cell.entries.clear();
+        }
+        generation = 1;
+    }
+
+    if (lastFrame == TimePoint::min() || fadeDuration <= Duration::zero()) {
+        fadeStep = 1;
+    } else {
+        fadeStep = std::chrono::duration<float>(now - lastFrame) / fadeDuration;
+    }
+    lastFrame = now;
+    fading = false;
+}
+
+void CrossTilePlacement::place(SymbolBucket& bucket, const mat4& matrix) {
+    std::vector<PlacedSymbol>* symbols = bucket.getPlacedSymbols();
+    if (symbols) {
+        place(*symbols, bucket.getCollisionTile(), bucket.layout, matrix);
+    }
+}
+
+void CrossTilePlacement::place(std::vector<PlacedSymbol>& symbols, const CollisionTile& tile,
+                               const StyleLayoutSymbol& layout, const mat4& matrix) {
+    const float scale = std::pow(2.0f, zoom - tile.zoom);
+    const float pixelRatio = 1.0f / tile.tilePixelRatio;
+
+    for (PlacedSymbol& symbol : symbols) {
+        // Symbols that their own tile doesn't show at this zoom level neither block nor get blocked.
+        const bool textShown = symbol.text.count && scale >= symbol.textScale;
+        const bool iconShown = symbol.icon.count && scale >= symbol.iconScale;
+
+        if (textShown) getEntries(symbol.textBoxes, matrix, pixelRatio, scale, textEntries);
+        if (iconShown) getEntries(symbol.iconBoxes, matrix, pixelRatio, scale, iconEntries);
+
+        const bool visible =
+            !(textShown && !layout.text.allow_overlap && collides(textEntries, &tile)) &&
+            !(iconShown && !layout.icon.allow_overlap && collides(iconEntries, &tile));
+
+        if (visible) {
+            if (textShown && !layout.text.ignore_placement) insert(textEntries, &tile);
+            if (iconShown && !layout.icon.ignore_placement) insert(iconEntries, &tile);
+        }
+
+        updateOpacity(symbol, visible);
+    }
+}
+
+void CrossTilePlacement::getEntries(const std::vector<CollisionBox>& collisionBoxes, const mat4& matrix,
+                                    float pixelRatio, float scale, std::vector<Entry>& boxes) const {
+    boxes.clear();
+
+    for (const CollisionBox& box : collisionBoxes) {
+        // Boxes along a line label are only needed up to the scale at which the label fits
+        // into the remaining boxes.
+        if (scale >= box.maxScale) continue;
+
+        // The tile matrix maps tile units to clip space; convert that to screen pixels.
+        const float x = matrix[0] * box.anchor.x + matrix[4] * box.anchor.y + matrix[12];
+        const float y = matrix[1] * box.anchor.x + matrix[5] * box.anchor.y + matrix[13];
+        const float w = matrix[3] * box.anchor.x + matrix[7] * box.anchor.y + matrix[15];
+        const float px = (x / w + 1) * width / 2;
+        const float py = (1 - y / w) * height / 2;
+
+        // Collision boxes are sized in tile units at the tile's own zoom level, but labels keep
+        // their size in pixels, so the box doesn't scale with the map.
+        Entry entry { nullptr,
+            px + box.x1 * pixelRatio, py + box.y1 * pixelRatio,
+            px + box.x2 * pixelRatio, py + box.y2 * pixelRatio };
+
+        if (entry.x2 < -margin || entry.x1 > width + margin ||
+            entry.y2 < -margin || entry.y1 > height + margin) {
+            continue;
+        }
+
+        boxes.push_back(entry);
+    }
+}
+
+bool CrossTilePlacement::collides(const std::vector<Entry>& boxes, const CollisionTile* tile) {
+    for (const Entry& box : boxes) {
+        if (++queryID == 0) {
+            std::fill(visited.begin(), visited.end(), 0);
+            queryID = 1;
+        }
+
+        int32_t cx1, cy1, cx2, cy2;
+        getCellRange(box, cx1, cy1, cx2, cy2);
+
+        for (int32_t cy = cy1; cy <= cy2; ++cy) {
+            for (int32_t cx = cx1; cx <= cx2; ++cx) {
+                const Cell& cell = cells[cy * gridWidth + cx];
+                if (cell.generation != generation) continue;
+
+                for (const uint32_t index : cell.entries) {
+                    if (visited[index] == queryID) continue;
+                    visited[index] = queryID;
+
+                    const Entry& entry = entries[index];
+
+                    // Collisions within a tile have already been resolved by its CollisionTile.
+                    if (entry.tile == tile) continue;
+
+                    if (entry.x1 < box.x2 && box.x1 < entry.x2 &&
+                        entry.y1 < box.y2 && box.y1 < entry.y2) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void CrossTilePlacement::insert(const std::vector<Entry>& boxes, const CollisionTile* tile) {
+    for (Entry box : boxes) {
+        box.tile = tile;
+
+        const auto index = static_cast<uint32_t>(entries.size());
+        entries.push_back(box);
+        visited.push_back(0);
+
+        int32_t cx1, cy1, cx2, cy2;
+        getCellRange(box, cx1, cy1, cx2, cy2);
+
+        for (int32_t cy = cy1; cy <= cy2; ++cy) {
+            for (int32_t cx = cx1; cx <= cx2; ++cx) {
+                Cell& cell = cells[cy * gridWidth + cx];
+                if (cell.generation != generation) {
+                    cell.generation = generation;
+                    cell.entries.clear();
+                }
+                cell.entries.push_back(index);
+            }
+        }
+    }
+}
+
+void CrossTilePlacement::getCellRange(const Entry& entry, int32_t& cx1, int32_t& cy1, int32_t& cx2, int32_t& cy2) const {
+    const auto clamp = [](float position, int32_t size) {
+        return static_cast<int32_t>(std::fmax(0.0f, std::fmin(size - 1.0f, std::floor((position + margin) / cellSize))));
+    };
+
+    cx1 = clamp(entry.x1, gridWidth);
+    cy1 = clamp(entry.y1, gridHeight);
+    cx2 = clamp(entry.x2, gridWidth);
+    cy2 = clamp(entry.y2, gridHeight);
+}
+
+void CrossTilePlacement::updateOpacity(PlacedSymbol& symbol, bool visible) {
+    const float target = visible ? 1 : 0;
+
+    if (symbol.opacity < 0 || fadeStep >= 1) {
+        // Symbols that were just added are shown or hidden right away so that rebuilding a
+        // tile's buffers doesn't make all of its symbols fade in.
+        symbol.opacity = target;
+    } else if (symbol.opacity < target) {
+        symbol.opacity = std::fmin(target, symbol.opacity + fadeStep);
+    } else if (symbol.opacity > target) {
+        symbol.opacity = std::fmax(target, symbol.opacity - fadeStep);
+    }
+
+    if (symbol.opacity != target) {
+        fading = true;
+    }
+}
+
+}
@@ -0,0 +1,84 @@
+#ifndef MBGL_TEXT_CROSS_TILE_PLACEMENT
+#define MBGL_TEXT_CROSS_TILE_PLACEMENT
+
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace mbgl {
+
+class CollisionBox;
+class CollisionTile;
+class SymbolBucket;
+class StyleLayoutSymbol;
+class TransformState;
+struct PlacedSymbol;
+
+// Every tile places its symbols with its own CollisionTile, so symbols of neighboring tiles
+// (or of a parent tile shown in place of children that are still loading) may overlap. This
+// places all visible symbols once more per frame in screen space, hides symbols that collide
+// with a symbol of another tile and fades them in and out over the default fade duration.
+class CrossTilePlacement : private util::noncopyable {
+public:
+    // Starts a new frame; symbols placed in the previous frame no longer block anything.
+    void beginFrame(const TransformState&, const TimePoint& now, const Duration& fadeDuration);
+
+    // Places the symbols of a bucket that is drawn with the given tile matrix. Earlier buckets
+    // take precedence, so buckets should be passed in the same order every frame.
+    void place(SymbolBucket&, const mat4& matrix);
+    void place(std::vector<PlacedSymbol>&, const CollisionTile&, const StyleLayoutSymbol&, const mat4& matrix);
+
+    // Whether symbols are still fading in or out.
+    bool needsAnimation() const { return fading; }
+
+private:
+    struct Entry {
+        const CollisionTile* tile;
+        float x1, y1, x2, y2;
+    };
+
+    struct Cell {
+        uint32_t generation = 0;
+        std::vector<uint32_t> entries;
+    };
+
+    // Screen space bounds of the boxes that are active at the current zoom and near the viewport.
+    void getEntries(const std::vector<CollisionBox>&, const mat4& matrix,
+                    float pixelRatio, float scale, std::vector<Entry>&) const;
+    bool collides(const std::vector<Entry>&, const CollisionTile*);
+    void insert(const std::vector<Entry>&, const CollisionTile*);
+    void getCellRange(const Entry&, int32_t& cx1, int32_t& cy1, int32_t& cx2, int32_t& cy2) const;
+    void updateOpacity(PlacedSymbol&, bool visible);
+
+    // Grid over the viewport, extended by a margin for symbols that are partially visible.
+    static const int32_t cellSize = 64;
+    static const int32_t margin = 256;
+
+    std::vector<Entry> entries;
+    std::vector<Cell> cells;
+    uint32_t generation = 0;
+    int32_t gridWidth = 0;
+    int32_t gridHeight = 0;
+
+    std::vector<uint32_t> visited;
+    uint32_t queryID = 0;
+
+    // Scratch space for the boxes of the symbol that is being placed.
+    std::vector<Entry> textEntries;
+    std::vector<Entry> iconEntries;
+
+    float width = 0;
+    float height = 0;
+    float zoom = 0;
+
+    TimePoint lastFrame = TimePoint::min();
+    float fadeStep = 1;
+    bool fading = false;
+};
+
+}
+
+#endif
@@ -4,25 +4,63 @@
 
 namespace mbgl {
 
-void FontStack::insert(uint32_t id, const SDFGlyph &glyph) {
-    metrics.emplace(id, glyph.metrics);
-    bitmaps.emplace(id, glyph.bitmap);
-    sdfs.emplace(id, glyph);
+const uint32_t FontStack::GlyphTable::size;
+
+void FontStack::insert(uint32_t id, SDFGlyph glyph) {
+    if (add(id, std::move(glyph))) {
+        shapingCache.clear();
+    }
 }
 
-const std::map<uint32_t, GlyphMetrics> &FontStack::getMetrics() const {
-    return metrics;
+void FontStack::insert(std::vector<SDFGlyph> glyphs) {
+    bool added = false;
+    for (auto& glyph : glyphs) {
+        const uint32_t id = glyph.id;
+        added = add(id, std::move(glyph)) || added;
+    }
+
+    if (added) {
+        shapingCache.clear();
+    }
 }
 
-const std::map<uint32_t, SDFGlyph> &FontStack::getSDFs() const {
-    return sdfs;
+bool FontStack::add(uint32_t id, SDFGlyph glyph) {
+    const uint32_t index = id / GlyphTable::size;
+    if (index >= tables.size()) {
+        tables.resize(index + 1);
+    }
+
+    auto& table = tables[index];
+    if (!table) {
+        table = std::make_unique<GlyphTable>();
+    }
+
+    const uint32_t offset = id % GlyphTable::size;
+    if (table->present[offset]) {
+        return false;
+    }
+
+    table->present.set(offset);
+    table->metrics[offset] = glyph.metrics;
+    table->sdfs[offset] = std::make_unique<const SDFGlyph>(std::move(glyph));
+    glyphCount++;
+
+    return true;
 }
 
 const Shaping FontStack::getShaping(const std::u32string &string, const float maxWidth,
                                     const float lineHeight, const float horizontalAlign,
                                     const float verticalAlign, const float justify,
                                     const float spacing, const vec2<float> &translate) const {
-    Shaping shaping(translate.x * 24, translate.y * 24, string);
+    const ShapingKey key { string, maxWidth, lineHeight, horizontalAlign, verticalAlign,
+                           justify, spacing, translate.x, translate.y };
+
+    Shaping shaping;
+    if (shapingCache.get(key, shaping)) {
+        return shaping;
+    }
+
+    shaping = Shaping(translate.x * 24, translate.y * 24, string);
 
     // the y offset *should* be part of the font metadata
     const int32_t yOffset = -17;
@@ -32,18 +70,18 @@ const Shaping FontStack::getShaping(const std::u32string &string, const float ma
 
     // Loop through all characters of this label and shape.
     for (uint32_t chr : string) {
-        auto metric = metrics.find(chr);
-        if (metric != metrics.end()) {
+        const GlyphMetrics* metric = getMetrics(chr);
+        if (metric) {
             shaping.positionedGlyphs.emplace_back(chr, x, y);
-            x += metric->second.advance + spacing;
+            x += metric->advance + spacing;
         }
     }
 
-    if (shaping.positionedGlyphs.empty())
-        return shaping;
-
-    lineWrap(shaping, lineHeight, maxWidth, horizontalAlign, verticalAlign, justify);
+    if (!shaping.positionedGlyphs.empty()) {
+        lineWrap(shaping, lineHeight, maxWidth, horizontalAlign, verticalAlign, justify);
+    }
 
+    shapingCache.put(key, shaping);
     return shaping;
 }
 
@@ -59,12 +97,12 @@ void align(Shaping &shaping, const float justify, const float horizontalAlign,
     }
 }
 
-void justifyLine(std::vector<PositionedGlyph> &positionedGlyphs, const std::map<uint32_t, GlyphMetrics> &metrics, uint32_t start,
+void justifyLine(std::vector<PositionedGlyph> &positionedGlyphs, const FontStack &fontStack, uint32_t start,
                  uint32_t end, float justify) {
     PositionedGlyph &glyph = positionedGlyphs[end];
-    auto metric = metrics.find(glyph.glyph);
-    if (metric != metrics.end()) {
-        const uint32_t lastAdvance = metric->second.advance;
+    const GlyphMetrics* metric = fontStack.getMetrics(glyph.glyph);
+    if (metric) {
+        const uint32_t lastAdvance = metric->advance;
         const float lineIndent = float(glyph.x + lastAdvance) * justify;
 
         for (uint32_t j = start; j <= end; j++) {
@@ -104,7 +142,7 @@ void FontStack::lineWrap(Shaping &shaping, const float lineHeight, const float m
                 }
 
                 if (justify) {
-                    justifyLine(positionedGlyphs, metrics, lineStartIndex, lastSafeBreak - 1, justify);
+                    justifyLine(positionedGlyphs, *this, lineStartIndex, lastSafeBreak - 1, justify);
                 }
 
                 lineStartIndex = lastSafeBreak + 1;
@@ -120,14 +158,14 @@ void FontStack::lineWrap(Shaping &shaping, const float lineHeight, const float m
     }
 
     const PositionedGlyph& lastPositionedGlyph = positionedGlyphs.back();
-    const auto lastGlyphMetric = metrics.find(lastPositionedGlyph.glyph);
-    assert(lastGlyphMetric != metrics.end());
-    const uint32_t lastLineLength = lastPositionedGlyph.x + lastGlyphMetric->second.advance;
+    const GlyphMetrics* lastGlyphMetric = getMetrics(lastPositionedGlyph.glyph);
+    assert(lastGlyphMetric);
+    const uint32_t lastLineLength = lastPositionedGlyph.x + lastGlyphMetric->advance;
     maxLineLength = std::max(maxLineLength, lastLineLength);
 
     const uint32_t height = (line + 1) * lineHeight;
 
-    justifyLine(positionedGlyphs, metrics, lineStartIndex, uint32_t(positionedGlyphs.size()) - 1, justify);
+    justifyLine(positionedGlyphs, *this, lineStartIndex, uint32_t(positionedGlyphs.size()) - 1, justify);
     align(shaping, justify, horizontalAlign, verticalAlign, maxLineLength, lineHeight, line);
 
     // Calculate the bounding box
@@ -2,25 +2,69 @@
 #define MBGL_TEXT_FONT_STACK
 
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/vec.hpp>
 
+#include <array>
+#include <bitset>
+#include <memory>
+#include <vector>
+
 namespace mbgl {
 
 class FontStack {
 public:
-    void insert(uint32_t id, const SDFGlyph &glyph);
-    const std::map<uint32_t, GlyphMetrics> &getMetrics() const;
-    const std::map<uint32_t, SDFGlyph> &getSDFs() const;
+    // Glyphs that are already present are not replaced. Inserting flushes the shaping cache, so
+    // glyphs that arrive together, like those of a glyph range, should be inserted at once.
+    void insert(uint32_t id, SDFGlyph glyph);
+    void insert(std::vector<SDFGlyph> glyphs);
+
+    // Both return null if the glyph isn't part of the font stack (or hasn't been loaded yet).
+    inline const GlyphMetrics* getMetrics(uint32_t id) const {
+        const GlyphTable* table = getTable(id);
+        return table && table->present[id % GlyphTable::size] ? &table->metrics[id % GlyphTable::size] : nullptr;
+    }
+    inline const SDFGlyph* getSDF(uint32_t id) const {
+        const GlyphTable* table = getTable(id);
+        return table ? table->sdfs[id % GlyphTable::size].get() : nullptr;
+    }
+
+    bool empty() const { return glyphCount == 0; }
+    size_t size() const { return glyphCount; }
+
     const Shaping getShaping(const std::u32string &string, float maxWidth, float lineHeight,
                              float horizontalAlign, float verticalAlign, float justify,
                              float spacing, const vec2<float> &translate) const;
     void lineWrap(Shaping &shaping, float lineHeight, float maxWidth, float horizontalAlign,
                   float verticalAlign, float justify) const;
 
+    ShapingCache::Stats getShapingCacheStats() const { return shapingCache.getStats(); }
+
 private:
-    std::map<uint32_t, std::string> bitmaps;
-    std::map<uint32_t, GlyphMetrics> metrics;
-    std::map<uint32_t, SDFGlyph> sdfs;
+    // The glyphs of one GlyphRange. Metrics are stored densely because shaping looks them up for
+    // every character; the bitmaps are only stored once, in the SDFGlyph.
+    struct GlyphTable {
+        static const uint32_t size = 256;
+
+        std::bitset<size> present;
+        std::array<GlyphMetrics, size> metrics;
+        std::array<std::unique_ptr<const SDFGlyph>, size> sdfs;
+    };
+
+    // Returns whether the glyph was added.
+    bool add(uint32_t id, SDFGlyph glyph);
+
+    inline const GlyphTable* getTable(uint32_t id) const {
+        const uint32_t index = id / GlyphTable::size;
+        return index < tables.size() ? tables[index].get() : nullptr;
+    }
+
+    // Indexed by glyph id / 256; ranges that haven't been loaded are null.
+    std::vector<std::unique_ptr<GlyphTable>> tables;
+    size_t glyphCount = 0;
+
+    // Shapings only depend on the metrics above, so the cache is flushed whenever glyphs are added.
+    mutable ShapingCache shapingCache;
 };
 
 } // end namespace mbgl
@@ -11,22 +11,25 @@
 #include <mbgl/util/thread_context.hpp>
 #include <mbgl/util/token.hpp>
 #include <mbgl/util/url.hpp>
+#include <mbgl/util/work_request.hpp>
+#include <mbgl/util/worker.hpp>
 
 #include <sstream>
 
-namespace {
+namespace mbgl {
 
-void parseGlyphPBF(mbgl::FontStack& stack, const std::string& data) {
-    mbgl::pbf glyphs_pbf(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+std::vector<SDFGlyph> parseGlyphPBF(const std::string& data) {
+    std::vector<SDFGlyph> result;
+    pbf glyphs_pbf(reinterpret_cast<const uint8_t *>(data.data()), data.size());
 
     while (glyphs_pbf.next()) {
         if (glyphs_pbf.tag == 1) { // stacks
-            mbgl::pbf fontstack_pbf = glyphs_pbf.message();
+            pbf fontstack_pbf = glyphs_pbf.message();
             while (fontstack_pbf.next()) {
                 if (fontstack_pbf.tag == 3) { // glyphs
-                    mbgl::pbf glyph_pbf = fontstack_pbf.message();
+                    pbf glyph_pbf = fontstack_pbf.message();
 
-                    mbgl::SDFGlyph glyph;
+                    SDFGlyph glyph;
 
                     while (glyph_pbf.next()) {
                         if (glyph_pbf.tag == 1) { // id
@@ -48,7 +51,7 @@ void parseGlyphPBF(mbgl::FontStack& stack, const std::string& data) {
                         }
                     }
 
-                    stack.insert(glyph.id, glyph);
+                    result.push_back(std::move(glyph));
                 } else {
                     fontstack_pbf.skip();
                 }
@@ -57,13 +60,12 @@ void parseGlyphPBF(mbgl::FontStack& stack, const std::string& data) {
             glyphs_pbf.skip();
         }
     }
-}
 
+    return result;
 }
 
-namespace mbgl {
-
 GlyphPBF::GlyphPBF(GlyphStore* store,
+                   Worker& worker,
                    const std::string& fontStack,
                    const GlyphRange& glyphRange)
     : parsed(false) {
@@ -74,7 +76,7 @@ GlyphPBF::GlyphPBF(GlyphStore* store,
         return "";
     });
 
-    auto requestCallback = [this, store, fontStack, url](const Response &res) {
+    auto requestCallback = [this, store, &worker, fontStack, url](const Response &res) {
         req = nullptr;
 
         if (res.status != Response::Successful) {
@@ -82,8 +84,7 @@ GlyphPBF::GlyphPBF(GlyphStore* store,
             message <<  "Failed to load [" << url << "]: " << res.message;
             emitGlyphPBFLoadingFailed(message.str());
         } else {
-            data = res.data;
-            parse(store, fontStack, url);
+            parse(store, worker, fontStack, url, res.data);
         }
     };
 
@@ -97,25 +98,28 @@ GlyphPBF::~GlyphPBF() {
     }
 }
 
-void GlyphPBF::parse(GlyphStore* store, const std::string& fontStack, const std::string& url) {
+void GlyphPBF::parse(GlyphStore* store, Worker& worker, const std::string& fontStack,
+                     const std::string& url, const std::string& data) {
     if (data.empty()) {
         // If there is no data, this means we either haven't
         // received any data.
         return;
     }
 
-    try {
-        parseGlyphPBF(**store->getFontStack(fontStack), std::move(data));
-    } catch (const std::exception& ex) {
-        std::stringstream message;
-        message <<  "Failed to parse [" << url << "]: " << ex.what();
-        emitGlyphPBFLoadingFailed(message.str());
-        return;
-    }
+    workRequest = worker.parseGlyphs(data, [this, store, fontStack, url](GlyphParseResult result) {
+        if (result.is<std::string>()) {
+            std::stringstream message;
+            message <<  "Failed to parse [" << url << "]: " << result.get<std::string>();
+            emitGlyphPBFLoadingFailed(message.str());
+            return;
+        }
 
-    parsed = true;
+        store->getFontStack(fontStack)->insert(std::move(result.get<std::vector<SDFGlyph>>()));
 
-    emitGlyphPBFLoaded();
+        parsed = true;
+
+        emitGlyphPBFLoaded();
+    });
 }
 
 void GlyphPBF::setObserver(Observer* observer_) {
@@ -3,16 +3,28 @@
 
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/variant.hpp>
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 
 class GlyphStore;
 class FontStack;
 class Request;
+class Worker;
+class WorkRequest;
+
+using GlyphParseResult = mapbox::util::variant<
+    std::vector<SDFGlyph>, // success
+    std::string>;          // error
+
+// Decodes the glyphs of a glyph range PBF. Throws if the data is malformed.
+std::vector<SDFGlyph> parseGlyphPBF(const std::string& data);
 
 class GlyphPBF : private util::noncopyable {
 public:
@@ -24,7 +36,9 @@ public:
         virtual void onGlyphPBFLoadingFailed(std::exception_ptr error) = 0;
     };
 
+    // The PBF is decoded on the worker; the glyphs are added to the font stack on the calling thread.
     GlyphPBF(GlyphStore* store,
+             Worker& worker,
              const std::string& fontStack,
              const GlyphRange& glyphRange);
     virtual ~GlyphPBF();
@@ -39,12 +53,13 @@ private:
     void emitGlyphPBFLoaded();
     void emitGlyphPBFLoadingFailed(const std::string& message);
 
-    void parse(GlyphStore* store, const std::string& fontStack, const std::string& url);
+    void parse(GlyphStore* store, Worker& worker, const std::string& fontStack,
+               const std::string& url, const std::string& data);
 
-    std::string data;
     std::atomic<bool> parsed;
 
     Request* req = nullptr;
+    std::unique_ptr<WorkRequest> workRequest;
 
     Observer* observer = nullptr;
 };
@@ -5,6 +5,10 @@
 
 namespace mbgl {
 
+GlyphStore::GlyphStore(Worker& worker_)
+    : worker(worker_) {
+}
+
 void GlyphStore::requestGlyphRange(const std::string& fontStackName, const GlyphRange& range) {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
 
@@ -16,7 +20,7 @@ void GlyphStore::requestGlyphRange(const std::string& fontStackName, const Glyph
         return;
     }
 
-    auto glyphPBF = std::make_unique<GlyphPBF>(this, fontStackName, range);
+    auto glyphPBF = std::make_unique<GlyphPBF>(this, worker, fontStackName, range);
     glyphPBF->setObserver(this);
 
     rangeSets.emplace(range, std::move(glyphPBF));
@@ -51,6 +55,15 @@ bool GlyphStore::hasGlyphRanges(const std::string& fontStackName, const std::set
     return hasRanges;
 }
 
+void GlyphStore::prefetch(const std::string& fontStackName) {
+    // Basic Latin and Latin-1, Latin Extended-A/B, and General Punctuation (dashes and quotes).
+    static const GlyphRange commonRanges[] = { { 0, 255 }, { 256, 511 }, { 8192, 8447 } };
+
+    for (const auto& range : commonRanges) {
+        requestGlyphRange(fontStackName, range);
+    }
+}
+
 util::exclusive<FontStack> GlyphStore::getFontStack(const std::string& fontStack) {
     auto lock = std::make_unique<std::lock_guard<std::mutex>>(stacksMutex);
 
@@ -16,6 +16,8 @@
 
 namespace mbgl {
 
+class Worker;
+
 // The GlyphStore manages the loading and storage of Glyphs
 // and creation of FontStack objects. The GlyphStore lives
 // on the MapThread but can be queried from any thread.
@@ -29,7 +31,8 @@ public:
         virtual void onGlyphRangeLoadingFailed(std::exception_ptr error) = 0;
     };
 
-    GlyphStore() = default;
+    // Glyph PBFs are decoded on the worker.
+    explicit GlyphStore(Worker&);
     virtual ~GlyphStore() = default;
 
     util::exclusive<FontStack> getFontStack(const std::string& fontStack);
@@ -41,6 +44,11 @@ public:
     // can be called from any thread.
     bool hasGlyphRanges(const std::string& fontStackName, const std::set<GlyphRange>& glyphRanges);
 
+    // Requests the glyph ranges that almost every label needs (Latin and common punctuation)
+    // ahead of time, so that tiles don't have to wait for them in a partial parse. Must be
+    // called on the MapThread.
+    void prefetch(const std::string& fontStackName);
+
     void setURL(const std::string &url) {
         glyphURL = url;
     }
@@ -58,6 +66,7 @@ public:
 private:
     void requestGlyphRange(const std::string& fontStackName, const GlyphRange& range);
 
+    Worker& worker;
     std::string glyphURL;
 
     std::unordered_map<std::string, std::map<GlyphRange, std::unique_ptr<GlyphPBF>>> ranges;
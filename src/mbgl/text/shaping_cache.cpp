@@ -0,0 +1,85 @@
+#include <mbgl/text/shaping_cache.hpp>
+
+#include <functional>
+
+namespace mbgl {
+
+bool ShapingKey::operator==(const ShapingKey& rhs) const {
+    return text == rhs.text &&
+           maxWidth == rhs.maxWidth &&
+           lineHeight == rhs.lineHeight &&
+           horizontalAlign == rhs.horizontalAlign &&
+           verticalAlign == rhs.verticalAlign &&
+           justify == rhs.justify &&
+           spacing == rhs.spacing &&
+           translateX == rhs.translateX &&
+           translateY == rhs.translateY;
+}
+
+std::size_t ShapingKey::Hash::operator()(const ShapingKey& key) const {
+    std::size_t seed = std::hash<std::u32string>()(key.text);
+    for (const float value : { key.maxWidth, key.lineHeight, key.horizontalAlign, key.verticalAlign,
+                               key.justify, key.spacing, key.translateX, key.translateY }) {
+        seed ^= std::hash<float>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+ShapingCache::ShapingCache(size_t capacity_) : capacity(capacity_) {
+}
+
+bool ShapingCache::get(const ShapingKey& key, Shaping& shaping) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    shaping = it->second->second;
+    return true;
+}
+
+void ShapingCache::put(const ShapingKey& key, const Shaping& shaping) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = shaping;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    if (capacity == 0) {
+        return;
+    }
+
+    if (entries.size() >= capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+
+    entries.emplace_front(key, shaping);
+    index.emplace(key, entries.begin());
+}
+
+void ShapingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+}
+
+ShapingCache::Stats ShapingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.size = entries.size();
+    return stats;
+}
+
+}
@@ -0,0 +1,77 @@
+#ifndef MBGL_TEXT_SHAPING_CACHE
+#define MBGL_TEXT_SHAPING_CACHE
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+// Everything a Shaping depends on besides the glyph metrics of the font stack.
+struct ShapingKey {
+    std::u32string text;
+    float maxWidth;
+    float lineHeight;
+    float horizontalAlign;
+    float verticalAlign;
+    float justify;
+    float spacing;
+    float translateX;
+    float translateY;
+
+    bool operator==(const ShapingKey&) const;
+
+    struct Hash {
+        std::size_t operator()(const ShapingKey&) const;
+    };
+};
+
+// A bounded, least recently used cache of Shaping results. Labels such as street names repeat
+// across many tiles and zoom levels, so most of them only need to be shaped once. Can be used
+// from any thread.
+class ShapingCache : private util::noncopyable {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t size = 0;
+
+        double hitRate() const {
+            return hits + misses ? double(hits) / (hits + misses) : 0;
+        }
+    };
+
+    explicit ShapingCache(size_t capacity = 4096);
+
+    // Copies the cached shaping for the key into `shaping` and returns true, or returns false
+    // if there is none.
+    bool get(const ShapingKey&, Shaping& shaping);
+    void put(const ShapingKey&, const Shaping&);
+
+    // Drops all entries but keeps the statistics.
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    typedef std::list<std::pair<ShapingKey, Shaping>> Entries;
+
+    const size_t capacity;
+
+    // Most recently used entries are at the front.
+    Entries entries;
+    std::unordered_map<ShapingKey, Entries::iterator, ShapingKey::Hash> index;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    mutable std::mutex mutex;
+};
+
+}
+
+#endif
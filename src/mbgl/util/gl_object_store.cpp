@@ -3,6 +3,7 @@
 #include <mbgl/util/thread.hpp>
 #include <mbgl/geometry/vao.hpp>
 #include <mbgl/platform/gl.hpp>
+#include <mbgl/renderer/gl_config.hpp>
 
 namespace mbgl {
 namespace util {
@@ -25,6 +26,15 @@ void GLObjectStore::abandonTexture(uint32_t texture) {
 void GLObjectStore::performCleanup() {
     assert(ThreadContext::currentlyOn(ThreadType::Map));
 
+    if (abandonedVAOs.empty() && abandonedTextures.empty() && abandonedBuffers.empty()) {
+        return;
+    }
+
+    // Deleted object names may be handed out again, so cached bindings can't be trusted anymore.
+    if (gl::Config* config = ThreadContext::getGLConfig()) {
+        config->resetBindings();
+    }
+
     if (!abandonedVAOs.empty()) {
         MBGL_CHECK_ERROR(VertexArrayObject::Delete(static_cast<GLsizei>(abandonedVAOs.size()),
                                                    abandonedVAOs.data()));
@@ -0,0 +1,37 @@
+#include <mbgl/util/interned_string.hpp>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace mbgl {
+
+namespace {
+
+// Elements of an unordered_set don't move when it grows, so interned strings can point at them.
+// Interned strings are never released.
+std::unordered_set<std::string>& strings() {
+    static std::unordered_set<std::string> strings;
+    return strings;
+}
+
+std::mutex& stringsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+const std::string* intern(const std::string& string) {
+    std::lock_guard<std::mutex> lock(stringsMutex());
+    return &*strings().insert(string).first;
+}
+
+}
+
+InternedString::InternedString() {
+    static const std::string* empty = intern("");
+    string = empty;
+}
+
+InternedString::InternedString(const std::string& string_)
+    : string(intern(string_)) {}
+
+}
@@ -0,0 +1,43 @@
+#ifndef MBGL_UTIL_INTERNED_STRING
+#define MBGL_UTIL_INTERNED_STRING
+
+#include <functional>
+#include <string>
+
+namespace mbgl {
+
+// A string that is stored once per process. Copies share the stored string, so comparing and
+// hashing them only looks at its address. Creating one takes a global lock; do that when parsing
+// the style, not when rendering.
+class InternedString {
+public:
+    InternedString();
+    explicit InternedString(const std::string&);
+
+    const std::string& str() const { return *string; }
+    const char* c_str() const { return string->c_str(); }
+    bool empty() const { return string->empty(); }
+    operator const std::string&() const { return *string; }
+
+    bool operator==(const InternedString& other) const { return string == other.string; }
+    bool operator!=(const InternedString& other) const { return string != other.string; }
+
+private:
+    friend struct std::hash<InternedString>;
+    const std::string* string;
+};
+
+}
+
+namespace std {
+
+template <>
+struct hash<mbgl::InternedString> {
+    std::size_t operator()(const mbgl::InternedString& value) const {
+        return std::hash<const std::string*>()(value.string);
+    }
+};
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include <mbgl/util/raster.hpp>
 #include <mbgl/util/uv_detail.hpp>
+#include <mbgl/renderer/gl_config.hpp>
 
 #include <cassert>
 #include <cstring>
@@ -47,7 +48,7 @@ void Raster::bind(bool linear) {
     if (img && !textured) {
         upload();
     } else if (textured) {
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+        gl::bindTexture(texture);
     }
 
     GLuint new_filter = linear ? GL_LINEAR : GL_NEAREST;
@@ -61,7 +62,7 @@ void Raster::bind(bool linear) {
 void Raster::upload() {
     if (img && !textured) {
         texture = texturePool.getTextureID();
-        MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+        gl::bindTexture(texture);
 #ifndef GL_ES_VERSION_2_0
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 #endif
@@ -10,6 +10,11 @@
 namespace mbgl {
 
 class FileSource;
+class BufferArena;
+
+namespace gl {
+class Config;
+}
 
 namespace util {
 
@@ -59,6 +64,22 @@ public:
         current.get()->glObjectStore = glObjectStore;
     }
 
+    static gl::Config* getGLConfig() {
+        return current.get()->glConfig;
+    }
+
+    static void setGLConfig(gl::Config* glConfig) {
+        current.get()->glConfig = glConfig;
+    }
+
+    static BufferArena* getBufferArena() {
+        return current.get()->bufferArena;
+    }
+
+    static void setBufferArena(BufferArena* bufferArena) {
+        current.get()->bufferArena = bufferArena;
+    }
+
 private:
     std::string name;
     ThreadType type;
@@ -66,6 +87,8 @@ private:
 
     FileSource* fileSource = nullptr;
     GLObjectStore* glObjectStore = nullptr;
+    BufferArena* bufferArena = nullptr;
+    gl::Config* glConfig = nullptr;
 
     static uv::tls<ThreadContext> current;
 
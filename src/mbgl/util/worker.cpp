@@ -7,11 +7,45 @@
 #include <mbgl/util/pbf.hpp>
 #include <mbgl/renderer/raster_bucket.hpp>
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <future>
+#include <mutex>
 
 namespace mbgl {
 
+// Shared by all threads that take part in a parallelFor() call. Workers that only get to it after
+// all indices were taken return right away, so it must outlive the call that created it.
+class Worker::ParallelFor {
+public:
+    ParallelFor(std::size_t count_, std::function<void (std::size_t)> fn_)
+        : count(count_), fn(std::move(fn_)) {}
+
+    void run() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            fn(i);
+            if (++finished == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return finished == count; });
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void (std::size_t)> fn;
+    std::atomic<std::size_t> next { 0 };
+    std::atomic<std::size_t> finished { 0 };
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
 class Worker::Impl {
 public:
     Impl() = default;
@@ -46,10 +80,22 @@ public:
         }
     }
 
+    void parseGlyphs(std::string data, std::function<void (GlyphParseResult)> callback) {
+        try {
+            callback(parseGlyphPBF(data));
+        } catch (const std::exception& ex) {
+            callback(GlyphParseResult(std::string(ex.what())));
+        }
+    }
+
     void redoPlacement(TileWorker* worker, float angle, bool collisionDebug, std::function<void ()> callback) {
         worker->redoPlacement(angle, collisionDebug);
         callback();
     }
+
+    void parallelFor(std::shared_ptr<ParallelFor> job) {
+        job->run();
+    }
 };
 
 Worker::Worker(std::size_t count) {
@@ -76,9 +122,23 @@ std::unique_ptr<WorkRequest> Worker::parseLiveTile(TileWorker& worker, const Liv
     return threads[current]->invokeWithCallback(&Worker::Impl::parseLiveTile, callback, &worker, &tile);
 }
 
+std::unique_ptr<WorkRequest> Worker::parseGlyphs(std::string data, std::function<void (GlyphParseResult)> callback) {
+    current = (current + 1) % threads.size();
+    return threads[current]->invokeWithCallback(&Worker::Impl::parseGlyphs, callback, data);
+}
+
 std::unique_ptr<WorkRequest> Worker::redoPlacement(TileWorker& worker, float angle, bool collisionDebug, std::function<void ()> callback) {
     current = (current + 1) % threads.size();
     return threads[current]->invokeWithCallback(&Worker::Impl::redoPlacement, callback, &worker, angle, collisionDebug);
 }
 
+void Worker::parallelFor(std::size_t count, std::function<void (std::size_t)> fn) {
+    auto job = std::make_shared<ParallelFor>(count, std::move(fn));
+    for (std::size_t i = 0; i < threads.size() && i + 1 < count; i++) {
+        threads[i]->invoke(&Worker::Impl::parallelFor, job);
+    }
+    job->run();
+    job->wait();
+}
+
 } // end namespace mbgl
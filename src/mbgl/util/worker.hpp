@@ -4,6 +4,7 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/map/tile_worker.hpp>
+#include <mbgl/text/glyph_pbf.hpp>
 
 #include <functional>
 #include <memory>
@@ -46,13 +47,23 @@ public:
         const LiveTile&,
         std::function<void (TileParseResult)> callback);
 
+    Request parseGlyphs(
+        std::string data,
+        std::function<void (GlyphParseResult)> callback);
+
     Request redoPlacement(
         TileWorker&,
         float angle,
         bool collisionDebug,
         std::function<void ()> callback);
 
+    // Calls fn(i) for every i in [0, count) on the worker threads and the calling thread, and
+    // returns once all calls have finished. The calling thread keeps taking indices as well, so
+    // it never waits for a worker that is still busy with another request to start.
+    void parallelFor(std::size_t count, std::function<void (std::size_t)> fn);
+
 private:
+    class ParallelFor;
     class Impl;
     std::vector<std::unique_ptr<util::Thread<Impl>>> threads;
     std::size_t current = 0;
@@ -4,6 +4,7 @@
 
 #include <iosfwd>
 #include <array>
+#include <random>
 
 namespace mbgl {
 template <typename T> ::std::ostream& operator<<(::std::ostream& os, const Rect<T>& t) {
@@ -20,13 +21,89 @@ TEST(BinPack, Allocating) {
     rects[1] = bin.allocate(8, 17);
     ASSERT_EQ(mbgl::Rect<uint16_t>(32, 0, 8, 17), rects[1]);
     rects[2] = bin.allocate(8, 17);
-    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 48, 8, 17), rects[2]);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(40, 0, 8, 17), rects[2]);
 
     bin.release(rects[0]);
     rects[0] = bin.allocate(32, 24);
     ASSERT_EQ(mbgl::Rect<uint16_t>(0, 0, 32, 24), rects[0]);
     rects[3] = bin.allocate(32, 24);
-    ASSERT_EQ(mbgl::Rect<uint16_t>(32, 17, 32, 24), rects[3]);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(48, 0, 32, 24), rects[3]);
+}
+
+TEST(BinPack, ReusesSpaceUnderneath) {
+    mbgl::BinPack<uint16_t> bin(64, 64);
+
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 0, 32, 8), bin.allocate(32, 8));
+    ASSERT_EQ(mbgl::Rect<uint16_t>(32, 0, 32, 24), bin.allocate(32, 24));
+
+    // This one has to sit on top of the tall rect and covers up a 32x16 gap on the left.
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 24, 48, 16), bin.allocate(48, 16));
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 8, 32, 16), bin.allocate(32, 16));
+}
+
+TEST(BinPack, MergesReleasedRects) {
+    mbgl::BinPack<uint16_t> bin(64, 64);
+    std::vector<mbgl::Rect<uint16_t>> rects;
+
+    // Fill the bin with a 4x4 grid.
+    for (int i = 0; i < 16; i++) {
+        rects.push_back(bin.allocate(16, 16));
+        ASSERT_TRUE(rects.back().hasArea());
+    }
+    ASSERT_FALSE(bin.allocate(16, 16).hasArea());
+
+    // Release two rects in the middle that are next to each other, in both orders.
+    const auto adjacent = [&](const mbgl::Rect<uint16_t>& a, const mbgl::Rect<uint16_t>& b) {
+        return a.y == b.y && a.x + a.w == b.x;
+    };
+    for (const auto& a : rects) {
+        for (const auto& b : rects) {
+            if (adjacent(a, b) && a.x > 0 && a.y > 0 && a.y < 48) {
+                bin.release(b);
+                bin.release(a);
+
+                // Only the merged space fits a wide rect.
+                const auto rect = bin.allocate(32, 16);
+                ASSERT_EQ(mbgl::Rect<uint16_t>(a.x, a.y, 32, 16), rect);
+                return;
+            }
+        }
+    }
+    FAIL() << "no adjacent rects in the middle of the bin";
+}
+
+TEST(BinPack, FreeRectsAreFoundBySize) {
+    mbgl::BinPack<uint16_t> bin(64, 64);
+
+    const auto small = bin.allocate(8, 8);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(8, 0, 8, 8), bin.allocate(8, 8));
+    const auto large = bin.allocate(32, 16);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(16, 0, 32, 16), large);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(48, 0, 16, 16), bin.allocate(16, 16));
+
+    // Covers up a 16x8 gap underneath the small rects.
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 16, 64, 48), bin.allocate(64, 48));
+    bin.release(small);
+    bin.release(large);
+
+    // The two shortest free rects are too narrow.
+    EXPECT_EQ(mbgl::Rect<uint16_t>(16, 0, 24, 8), bin.allocate(24, 8));
+    EXPECT_EQ(mbgl::Rect<uint16_t>(0, 8, 16, 8), bin.allocate(16, 8));
+    EXPECT_EQ(mbgl::Rect<uint16_t>(0, 0, 8, 8), bin.allocate(8, 8));
+}
+
+TEST(BinPack, ReleasingLowersTheSkyline) {
+    mbgl::BinPack<uint16_t> bin(64, 64);
+
+    const auto bottom = bin.allocate(64, 32);
+    const auto top = bin.allocate(64, 32);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 32, 64, 32), top);
+
+    // Releasing the lower one first keeps it as a free rect; releasing the upper one then makes
+    // the entire bin available again.
+    bin.release(bottom);
+    bin.release(top);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 0, 64, 64), bin.allocate(64, 64));
 }
 
 
@@ -49,3 +126,35 @@ TEST(BinPack, Full) {
         rects.clear();
     }
 }
+
+TEST(BinPack, ReleasingEverythingFreesTheWholeBin) {
+    for (uint32_t seed = 0; seed < 300; seed++) {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<uint16_t> size(1, 32);
+        mbgl::BinPack<uint16_t> bin(128, 128);
+        std::vector<mbgl::Rect<uint16_t>> rects;
+
+        for (int i = 0; i < 200; i++) {
+            if (!rects.empty() && random() % 3 == 0) {
+                const size_t index = random() % rects.size();
+                bin.release(rects[index]);
+                rects.erase(rects.begin() + index);
+            } else {
+                const auto rect = bin.allocate(size(random), size(random));
+                if (rect.hasArea()) {
+                    for (const auto& other : rects) {
+                        ASSERT_TRUE(rect.x >= other.x + other.w || other.x >= rect.x + rect.w ||
+                                    rect.y >= other.y + other.h || other.y >= rect.y + rect.h)
+                            << "seed " << seed << ": " << rect << " overlaps " << other;
+                    }
+                    rects.push_back(rect);
+                }
+            }
+        }
+
+        for (const auto& rect : rects) {
+            bin.release(rect);
+        }
+        ASSERT_EQ(mbgl::Rect<uint16_t>(0, 0, 128, 128), bin.allocate(128, 128)) << "seed " << seed;
+    }
+}
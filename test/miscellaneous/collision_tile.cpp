@@ -0,0 +1,179 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/text/collision_tile.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace mbgl;
+
+namespace {
+
+// Deterministic pseudo-random numbers so that the fixture is the same on every run.
+class Random {
+public:
+    float operator()(float min, float max) {
+        state = state * 1103515245u + 12345u;
+        return min + (max - min) * float((state >> 8) & 0xFFFF) / 0xFFFF;
+    }
+
+private:
+    uint32_t state = 1;
+};
+
+std::vector<CollisionFeature> denseLabels(size_t count) {
+    Random random;
+    std::vector<CollisionFeature> features;
+    const std::vector<Coordinate> line;
+
+    for (size_t i = 0; i < count; i++) {
+        // Labels are spread over the tile and its buffer.
+        const float x = random(-128, 4096 + 128);
+        const float y = random(-128, 4096 + 128);
+        const float width = random(20, 300);
+        const float height = random(10, 40);
+        features.emplace_back(line, Anchor(x, y, 0, 0.5f), -height / 2, height / 2, -width / 2, width / 2, 1.0f, 2.0f, false);
+
+        // Some labels consist of several boxes that disappear at different scales, like line labels.
+        if (i % 4 == 0) {
+            for (int b = 1; b <= 3; b++) {
+                features.back().boxes.emplace_back(vec2<float>(x + b * 20, y), -10, -10, 10, 10, 1.0f + b * 0.25f);
+            }
+        }
+    }
+
+    return features;
+}
+
+// Reference implementation that tests every new box against every placed box.
+class BruteForceCollisionTile {
+public:
+    BruteForceCollisionTile(float angle, float pitch) {
+        const float angle_sin = std::sin(angle);
+        const float angle_cos = std::cos(angle);
+        rotationMatrix = {{ angle_cos, -angle_sin, angle_sin, angle_cos }};
+        yStretch = std::pow(1.0f / std::cos(pitch / 180 * M_PI), 1.3);
+    }
+
+    float placeFeature(const CollisionFeature& feature) const {
+        float minPlacementScale = minScale;
+
+        for (const auto& box : feature.boxes) {
+            const auto anchor = box.anchor.matMul(rotationMatrix);
+
+            for (const auto& blocking : placed) {
+                const auto blockingAnchor = blocking.anchor.matMul(rotationMatrix);
+                if (anchor.x + box.x1 > blockingAnchor.x + blocking.x2 ||
+                    blockingAnchor.x + blocking.x1 > anchor.x + box.x2 ||
+                    anchor.y + box.y1 * yStretch > blockingAnchor.y + blocking.y2 * yStretch ||
+                    blockingAnchor.y + blocking.y1 * yStretch > anchor.y + box.y2 * yStretch) {
+                    continue;
+                }
+
+                float s1 = (blocking.x1 - box.x2) / (anchor.x - blockingAnchor.x);
+                float s2 = (blocking.x2 - box.x1) / (anchor.x - blockingAnchor.x);
+                float s3 = (blocking.y1 - box.y2) * yStretch / (anchor.y - blockingAnchor.y);
+                float s4 = (blocking.y2 - box.y1) * yStretch / (anchor.y - blockingAnchor.y);
+
+                if (std::isnan(s1) || std::isnan(s2)) s1 = s2 = 1;
+                if (std::isnan(s3) || std::isnan(s4)) s3 = s4 = 1;
+
+                float collisionFreeScale = std::fmin(std::fmax(s1, s2), std::fmax(s3, s4));
+                collisionFreeScale = std::fmin(collisionFreeScale, blocking.maxScale);
+                collisionFreeScale = std::fmin(collisionFreeScale, box.maxScale);
+
+                if (collisionFreeScale > minPlacementScale &&
+                        collisionFreeScale >= blocking.placementScale) {
+                    minPlacementScale = collisionFreeScale;
+                }
+
+                if (minPlacementScale >= maxScale) return minPlacementScale;
+            }
+        }
+
+        return minPlacementScale;
+    }
+
+    void insertFeature(CollisionFeature& feature, float minPlacementScale) {
+        for (auto& box : feature.boxes) {
+            box.placementScale = minPlacementScale;
+        }
+        if (minPlacementScale < maxScale) {
+            placed.insert(placed.end(), feature.boxes.begin(), feature.boxes.end());
+        }
+    }
+
+private:
+    const float minScale = 0.5f;
+    const float maxScale = 2.0f;
+    std::array<float, 4> rotationMatrix;
+    float yStretch;
+    std::vector<CollisionBox> placed;
+};
+
+}
+
+TEST(CollisionTile, MatchesBruteForcePlacement) {
+    CollisionTile tile(14, 4096, 512, 0, false);
+
+    for (const float angle : { 0.0f, 0.3f, float(M_PI / 4), 2.0f, float(-M_PI) }) {
+        for (const float pitch : { 0.0f, 45.0f }) {
+            tile.reset(angle, pitch);
+            BruteForceCollisionTile reference(angle, pitch);
+
+            auto features = denseLabels(2000);
+            auto referenceFeatures = features;
+
+            size_t placed = 0;
+            for (size_t i = 0; i < features.size(); i++) {
+                const float scale = tile.placeFeature(features[i]);
+                const float expected = reference.placeFeature(referenceFeatures[i]);
+                // Once a feature is blocked, the exact scale depends on the order in which blocking
+                // boxes are visited, so only compare whether it was placed.
+                if (expected >= tile.maxScale) {
+                    ASSERT_GE(scale, tile.maxScale) << "feature " << i << " at angle " << angle << ", pitch " << pitch;
+                } else {
+                    ASSERT_FLOAT_EQ(expected, scale) << "feature " << i << " at angle " << angle << ", pitch " << pitch;
+                }
+
+                tile.insertFeature(features[i], scale);
+                reference.insertFeature(referenceFeatures[i], expected);
+                if (scale < tile.maxScale) placed++;
+            }
+
+            // The fixture is dense enough that labels actually collide.
+            EXPECT_GT(placed, 0u);
+            EXPECT_LT(placed, features.size());
+        }
+    }
+}
+
+TEST(CollisionTile, ResetRemovesPlacedFeatures) {
+    CollisionTile tile(14, 4096, 512, 0, false);
+    const std::vector<Coordinate> line;
+
+    CollisionFeature first(line, Anchor(2048, 2048, 0, 0.5f), -10, 10, -50, 50, 1.0f, 0.0f, false);
+    EXPECT_EQ(tile.minScale, tile.placeFeature(first));
+    tile.insertFeature(first, tile.minScale);
+
+    CollisionFeature second(line, Anchor(2048, 2048, 0, 0.5f), -10, 10, -50, 50, 1.0f, 0.0f, false);
+    EXPECT_LE(tile.maxScale, tile.placeFeature(second));
+
+    tile.reset(0.5f, 0);
+    EXPECT_EQ(tile.minScale, tile.placeFeature(second));
+}
+
+TEST(CollisionTile, LabelsOutsideTheTile) {
+    CollisionTile tile(14, 4096, 512, 0, false);
+    const std::vector<Coordinate> line;
+
+    // Boxes far outside the tile end up in the border cells and still collide.
+    CollisionFeature first(line, Anchor(-10000, 20000, 0, 0.5f), -10, 10, -50, 50, 1.0f, 0.0f, false);
+    tile.insertFeature(first, tile.placeFeature(first));
+
+    CollisionFeature second(line, Anchor(-10000, 20000, 0, 0.5f), -10, 10, -50, 50, 1.0f, 0.0f, false);
+    EXPECT_LE(tile.maxScale, tile.placeFeature(second));
+
+    CollisionFeature third(line, Anchor(-9000, 20000, 0, 0.5f), -10, 10, -50, 50, 1.0f, 0.0f, false);
+    EXPECT_EQ(tile.minScale, tile.placeFeature(third));
+}
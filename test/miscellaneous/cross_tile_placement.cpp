@@ -0,0 +1,165 @@
+#include "../fixtures/util.hpp"
+#include "../fixtures/mock_view.hpp"
+
+#include <mbgl/text/cross_tile_placement.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/renderer/symbol_bucket.hpp>
+#include <mbgl/map/transform.hpp>
+
+#include <tuple>
+
+using namespace mbgl;
+
+namespace {
+
+// A 512 × 512 viewport at z14 that shows a 4096 unit tile per 512 pixels, so that one tile unit
+// is 1/8 pixel. Tiles are offset horizontally by a multiple of their size.
+class Fixture {
+public:
+    Fixture() : transform(view) {
+        transform.resize({{ 512, 512 }});
+        transform.setZoom(14);
+    }
+
+    mat4 matrix(int tileX) const {
+        mat4 result = {{ 0 }};
+        result[0] = 2.0f / 4096;
+        result[5] = -2.0f / 4096;
+        result[12] = tileX * 2 - 1;
+        result[13] = 1;
+        result[15] = 1;
+        return result;
+    }
+
+    // A label that is 160 pixels wide and 20 pixels high.
+    static PlacedSymbol label(float x, float y) {
+        PlacedSymbol symbol;
+        symbol.textBoxes.emplace_back(vec2<float>(x, y), -640, -80, 640, 80, 2);
+        symbol.text.count = 1;
+        return symbol;
+    }
+
+    void beginFrame(const TimePoint& now) {
+        placement.beginFrame(transform.getState(), now, fadeDuration);
+    }
+
+    MockView view;
+    Transform transform;
+    CrossTilePlacement placement;
+    StyleLayoutSymbol layout;
+    const Duration fadeDuration = std::chrono::milliseconds(300);
+    const TimePoint start = Clock::now();
+};
+
+}
+
+TEST(CrossTilePlacement, SeamCollisionHidesLaterTile) {
+    Fixture fixture;
+    CollisionTile left(14, 4096, 512, 0, false);
+    CollisionTile right(14, 4096, 512, 0, false);
+
+    // Both labels straddle the seam between the tiles.
+    std::vector<PlacedSymbol> leftSymbols { Fixture::label(4000, 2048) };
+    std::vector<PlacedSymbol> rightSymbols { Fixture::label(-50, 2048) };
+
+    fixture.beginFrame(fixture.start);
+    fixture.placement.place(leftSymbols, left, fixture.layout, fixture.matrix(0));
+    fixture.placement.place(rightSymbols, right, fixture.layout, fixture.matrix(1));
+
+    // Symbols that weren't placed before are shown or hidden right away.
+    EXPECT_EQ(1, leftSymbols[0].opacity);
+    EXPECT_EQ(0, rightSymbols[0].opacity);
+    EXPECT_FALSE(fixture.placement.needsAnimation());
+
+    // Labels that don't overlap across the seam are both shown.
+    std::vector<PlacedSymbol> farSymbols { Fixture::label(2048, 1000) };
+    fixture.placement.place(farSymbols, right, fixture.layout, fixture.matrix(1));
+    EXPECT_EQ(1, farSymbols[0].opacity);
+}
+
+TEST(CrossTilePlacement, NoHidingWithinTile) {
+    Fixture fixture;
+    CollisionTile tile(14, 4096, 512, 0, false);
+
+    // Collisions within a tile have already been resolved by its CollisionTile.
+    std::vector<PlacedSymbol> symbols { Fixture::label(2048, 2048), Fixture::label(2100, 2048) };
+
+    fixture.beginFrame(fixture.start);
+    fixture.placement.place(symbols, tile, fixture.layout, fixture.matrix(0));
+    EXPECT_EQ(1, symbols[0].opacity);
+    EXPECT_EQ(1, symbols[1].opacity);
+}
+
+TEST(CrossTilePlacement, FadeTiming) {
+    Fixture fixture;
+    CollisionTile left(14, 4096, 512, 0, false);
+    CollisionTile right(14, 4096, 512, 0, false);
+
+    std::vector<PlacedSymbol> leftSymbols { Fixture::label(4000, 2048) };
+    std::vector<PlacedSymbol> rightSymbols { Fixture::label(-50, 2048) };
+
+    fixture.beginFrame(fixture.start);
+    fixture.placement.place(leftSymbols, left, fixture.layout, fixture.matrix(0));
+    fixture.placement.place(rightSymbols, right, fixture.layout, fixture.matrix(1));
+    ASSERT_EQ(0, rightSymbols[0].opacity);
+
+    // Without the left tile, the right label fades in over the fade duration.
+    fixture.beginFrame(fixture.start + std::chrono::milliseconds(150));
+    fixture.placement.place(rightSymbols, right, fixture.layout, fixture.matrix(1));
+    EXPECT_FLOAT_EQ(0.5, rightSymbols[0].opacity);
+    EXPECT_TRUE(fixture.placement.needsAnimation());
+
+    fixture.beginFrame(fixture.start + std::chrono::milliseconds(300));
+    fixture.placement.place(rightSymbols, right, fixture.layout, fixture.matrix(1));
+    EXPECT_FLOAT_EQ(1, rightSymbols[0].opacity);
+    EXPECT_FALSE(fixture.placement.needsAnimation());
+
+    // When the left tile comes back, it takes precedence and the right label fades out.
+    fixture.beginFrame(fixture.start + std::chrono::milliseconds(375));
+    fixture.placement.place(leftSymbols, left, fixture.layout, fixture.matrix(0));
+    fixture.placement.place(rightSymbols, right, fixture.layout, fixture.matrix(1));
+    EXPECT_EQ(1, leftSymbols[0].opacity);
+    EXPECT_FLOAT_EQ(0.75, rightSymbols[0].opacity);
+    EXPECT_TRUE(fixture.placement.needsAnimation());
+
+    fixture.beginFrame(fixture.start + std::chrono::milliseconds(1000));
+    fixture.placement.place(leftSymbols, left, fixture.layout, fixture.matrix(0));
+    fixture.placement.place(rightSymbols, right, fixture.layout, fixture.matrix(1));
+    EXPECT_EQ(0, rightSymbols[0].opacity);
+    EXPECT_FALSE(fixture.placement.needsAnimation());
+}
+
+TEST(CrossTilePlacement, DrawRuns) {
+    const auto symbol = [](uint32_t group, uint32_t first, uint32_t count, float opacity) {
+        PlacedSymbol result;
+        result.text.group = group;
+        result.text.first = first;
+        result.text.count = count;
+        result.opacity = opacity;
+        return result;
+    };
+
+    const std::vector<PlacedSymbol> symbols {
+        symbol(0, 0, 4, -1),
+        symbol(0, 4, 2, 1),
+        symbol(0, 6, 0, 0.5),  // empty
+        symbol(0, 6, 2, 0.5),
+        symbol(0, 8, 2, 0),    // hidden
+        symbol(0, 10, 2, 0.5),
+        symbol(1, 0, 3, 0.5),  // new group
+        symbol(1, 3, 3, 0.5),
+    };
+
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t, float>> runs;
+    forEachDrawRun(symbols, &PlacedSymbol::text, [&](const PlacedSymbol::Range& run, float opacity) {
+        runs.emplace_back(run.group, run.first, run.count, opacity);
+    });
+
+    const std::vector<std::tuple<uint32_t, uint32_t, uint32_t, float>> expected {
+        std::make_tuple(0, 0, 6, 1.0f),
+        std::make_tuple(0, 6, 2, 0.5f),
+        std::make_tuple(0, 10, 2, 0.5f),
+        std::make_tuple(1, 0, 6, 0.5f),
+    };
+    EXPECT_EQ(expected, runs);
+}
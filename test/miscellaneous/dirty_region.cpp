@@ -0,0 +1,67 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/geometry/dirty_region.hpp>
+
+using namespace mbgl;
+
+typedef DirtyRegion::Area Area;
+
+TEST(DirtyRegion, MergesNearbyRects) {
+    DirtyRegion region(1024, 1024);
+    EXPECT_TRUE(region.empty());
+
+    // Adjacent glyphs become one upload.
+    region.add(Area(0, 0, 20, 20));
+    region.add(Area(20, 0, 20, 20));
+    ASSERT_EQ(1u, region.getRects().size());
+    EXPECT_EQ(Area(0, 0, 40, 20), region.getRects()[0]);
+
+    // Far away ones don't.
+    region.add(Area(500, 500, 20, 20));
+    ASSERT_EQ(2u, region.getRects().size());
+
+    // A rect that connects two others merges all three.
+    region.add(Area(0, 20, 40, 20));
+    region.add(Area(500, 520, 20, 20));
+    ASSERT_EQ(2u, region.getRects().size());
+    EXPECT_EQ(Area(0, 0, 40, 40), region.getRects()[0]);
+    EXPECT_EQ(Area(500, 500, 20, 40), region.getRects()[1]);
+
+    region.clear();
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(DirtyRegion, ClampsAndCollapses) {
+    DirtyRegion region(256, 256);
+
+    region.add(Area(250, 250, 20, 20));
+    ASSERT_EQ(1u, region.getRects().size());
+    EXPECT_EQ(Area(250, 250, 6, 6), region.getRects()[0]);
+    EXPECT_FALSE(region.isAll());
+
+    // Too many scattered rects collapse into their bounding box.
+    region.clear();
+    for (uint16_t i = 0; i < 64; i++) {
+        region.add(Area((i % 8) * 32, (i / 8) * 32, 4, 4));
+    }
+    ASSERT_EQ(1u, region.getRects().size());
+
+    region.addAll();
+    EXPECT_TRUE(region.isAll());
+}
+
+TEST(DirtyRegion, Extract) {
+    const uint8_t image[] = {
+        0, 1, 2, 3,
+        4, 5, 6, 7,
+        8, 9, 10, 11,
+    };
+    std::vector<uint8_t> buffer;
+
+    // Full rows are returned in place.
+    EXPECT_EQ(image + 4, DirtyRegion::extract(image, 4, Area(0, 1, 4, 2), buffer));
+
+    const uint8_t* pixels = DirtyRegion::extract(image, 4, Area(1, 1, 2, 2), buffer);
+    EXPECT_EQ(buffer.data(), pixels);
+    EXPECT_EQ((std::vector<uint8_t>{ 5, 6, 9, 10 }), buffer);
+}
@@ -0,0 +1,78 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/text/font_stack.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+SDFGlyph glyph(uint32_t id, uint32_t advance) {
+    SDFGlyph result;
+    result.id = id;
+    result.bitmap = std::string(10 * 10, char(id));
+    result.metrics.width = 4;
+    result.metrics.height = 4;
+    result.metrics.advance = advance;
+    return result;
+}
+
+}
+
+TEST(FontStack, Lookup) {
+    FontStack stack;
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(nullptr, stack.getMetrics('a'));
+    EXPECT_EQ(nullptr, stack.getSDF(0x4E2D));
+
+    stack.insert('a', glyph('a', 12));
+    stack.insert(0x4E2D, glyph(0x4E2D, 24));
+    EXPECT_EQ(2u, stack.size());
+
+    ASSERT_NE(nullptr, stack.getMetrics('a'));
+    EXPECT_EQ(12u, stack.getMetrics('a')->advance);
+    ASSERT_NE(nullptr, stack.getSDF(0x4E2D));
+    EXPECT_EQ(24u, stack.getSDF(0x4E2D)->metrics.advance);
+    EXPECT_EQ(100u, stack.getSDF(0x4E2D)->bitmap.size());
+
+    // Other glyphs in a range that has been loaded, and ranges in between, are still missing.
+    EXPECT_EQ(nullptr, stack.getMetrics('b'));
+    EXPECT_EQ(nullptr, stack.getSDF('b'));
+    EXPECT_EQ(nullptr, stack.getMetrics(0x1000));
+    EXPECT_EQ(nullptr, stack.getMetrics(0x10FFFF));
+}
+
+TEST(FontStack, InsertKeepsExistingGlyphs) {
+    FontStack stack;
+    stack.insert('a', glyph('a', 12));
+    stack.insert('a', glyph('a', 20));
+
+    EXPECT_EQ(1u, stack.size());
+    EXPECT_EQ(12u, stack.getMetrics('a')->advance);
+    EXPECT_EQ(12u, stack.getSDF('a')->metrics.advance);
+}
+
+TEST(FontStack, InsertBatch) {
+    FontStack stack;
+    stack.insert({ glyph('a', 12), glyph('b', 14), glyph(0x4E2D, 24) });
+    EXPECT_EQ(3u, stack.size());
+    EXPECT_EQ(14u, stack.getMetrics('b')->advance);
+    EXPECT_EQ(24u, stack.getMetrics(0x4E2D)->advance);
+
+    const auto shape = [&] {
+        return stack.getShaping(U"ab", 0, 24, 0.5, 0.5, 0.5, 0, vec2<float>(0, 0));
+    };
+    shape();
+    shape();
+    EXPECT_EQ(1u, stack.getShapingCacheStats().hits);
+    EXPECT_EQ(1u, stack.getShapingCacheStats().size);
+
+    // Glyphs that are all present already keep the shapings.
+    stack.insert({ glyph('a', 20), glyph('b', 20) });
+    EXPECT_EQ(1u, stack.getShapingCacheStats().size);
+    EXPECT_EQ(12u, stack.getMetrics('a')->advance);
+
+    // New glyphs may change them.
+    stack.insert({ glyph('a', 20), glyph('c', 16) });
+    EXPECT_EQ(0u, stack.getShapingCacheStats().size);
+    EXPECT_EQ(4u, stack.size());
+}
@@ -0,0 +1,76 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/map/frame_statistics.hpp>
+
+#include <rapidjson/document.h>
+
+using namespace mbgl;
+
+namespace {
+
+FrameSection section(const std::string& name, int cpu) {
+    FrameSection result;
+    result.name = name;
+    result.cpuTime = std::chrono::milliseconds(cpu);
+    return result;
+}
+
+}
+
+TEST(FrameStatistics, Overdraw) {
+    FrameStatistics statistics;
+    statistics.pixels = 100;
+    EXPECT_EQ(0, statistics.overdraw());
+
+    statistics.passes.push_back(section("opaque", 1));
+    statistics.passes.back().fragments = 100;
+    statistics.passes.back().hasFragments = true;
+    statistics.passes.push_back(section("translucent", 1));
+    statistics.passes.back().fragments = 150;
+    statistics.passes.back().hasFragments = true;
+
+    // Counts of frames whose queries didn't finish in time are ignored.
+    statistics.passes.push_back(section("debug", 1));
+    statistics.passes.back().fragments = 1000;
+    EXPECT_DOUBLE_EQ(2.5, statistics.overdraw());
+
+    statistics.pixels = 0;
+    EXPECT_EQ(0, statistics.overdraw());
+}
+
+TEST(FrameStatistics, JSON) {
+    FrameStatistics statistics;
+    statistics.frame = 42;
+    statistics.pixels = 10;
+    statistics.redundantGLCalls = 7;
+    statistics.total = section("frame", 16);
+    statistics.total.gpuTime = std::chrono::milliseconds(8);
+    statistics.total.hasGPUTime = true;
+    statistics.passes.push_back(section("opaque", 2));
+    statistics.passes.back().fragments = 30;
+    statistics.passes.back().hasFragments = true;
+    statistics.layers.push_back(section("water", 1));
+
+    rapidjson::Document doc;
+    doc.Parse<0>(statistics.toJSON().c_str());
+    ASSERT_FALSE(doc.HasParseError());
+
+    EXPECT_EQ(42u, doc["frame"].GetUint64());
+    EXPECT_EQ(7u, doc["redundantGLCalls"].GetUint64());
+    EXPECT_DOUBLE_EQ(3, doc["overdraw"].GetDouble());
+
+    EXPECT_STREQ("frame", doc["total"]["name"].GetString());
+    EXPECT_DOUBLE_EQ(16, doc["total"]["cpu"].GetDouble());
+    EXPECT_DOUBLE_EQ(8, doc["total"]["gpu"].GetDouble());
+    EXPECT_FALSE(doc["total"].HasMember("fragments"));
+
+    ASSERT_EQ(1u, doc["passes"].Size());
+    EXPECT_STREQ("opaque", doc["passes"][0u]["name"].GetString());
+    EXPECT_EQ(30u, doc["passes"][0u]["fragments"].GetUint64());
+
+    // Sections without GPU timings don't report them.
+    ASSERT_EQ(1u, doc["layers"].Size());
+    EXPECT_STREQ("water", doc["layers"][0u]["name"].GetString());
+    EXPECT_DOUBLE_EQ(1, doc["layers"][0u]["cpu"].GetDouble());
+    EXPECT_FALSE(doc["layers"][0u].HasMember("gpu"));
+}
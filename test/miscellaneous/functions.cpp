@@ -56,3 +56,36 @@ TEST(Function, Stops) {
     EXPECT_EQ(4.75, slope_4.evaluate(2.75));
     EXPECT_EQ(10, slope_4.evaluate(8));
 }
+
+TEST(Function, ConstantRange) {
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    mbgl::StopsFunction<float> slope({ { 4, 1.5 }, { 6, 1.5 }, { 8, 3 }, { 22, 3 } }, 1.75);
+    EXPECT_EQ(std::make_pair(-infinity, 4.0f), slope.getConstantRange(2));
+    EXPECT_EQ(std::make_pair(4.0f, 6.0f), slope.getConstantRange(5));
+    EXPECT_EQ(std::make_pair(7.0f, 7.0f), slope.getConstantRange(7));
+    EXPECT_EQ(std::make_pair(8.0f, 8.0f), slope.getConstantRange(8));
+    EXPECT_EQ(std::make_pair(8.0f, 22.0f), slope.getConstantRange(15));
+    EXPECT_EQ(std::make_pair(22.0f, infinity), slope.getConstantRange(23));
+
+    // Values in a constant range evaluate to the same result.
+    EXPECT_EQ(slope.evaluate(4), slope.evaluate(6));
+    EXPECT_EQ(slope.evaluate(8), slope.evaluate(22));
+
+    mbgl::StopsFunction<float> empty({}, 1);
+    EXPECT_EQ(std::make_pair(-infinity, infinity), empty.getConstantRange(10));
+}
+
+TEST(Function, UnsortedStops) {
+    mbgl::StopsFunction<float> sorted({ { 0, 2 }, { 4, 6 }, { 8, 10 } }, 1.5);
+    mbgl::StopsFunction<float> unsorted({ { 8, 10 }, { 0, 2 }, { 4, 6 } }, 1.5);
+    for (float z = -1; z <= 10; z += 0.25) {
+        EXPECT_EQ(sorted.evaluate(z), unsorted.evaluate(z)) << "at zoom " << z;
+    }
+
+    // Of several stops at the same zoom level, the first one is used.
+    mbgl::StopsFunction<float> duplicate({ { 4, 1 }, { 4, 3 }, { 8, 5 } }, 1);
+    EXPECT_EQ(1, duplicate.evaluate(2));
+    EXPECT_EQ(1, duplicate.evaluate(4));
+    EXPECT_EQ(3, duplicate.evaluate(6));
+}
@@ -0,0 +1,49 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/renderer/gl_config.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+struct Counter {
+    using Type = int;
+    static const Type Default = 0;
+    static int calls;
+    inline static void Set(const Type&) {
+        calls++;
+    }
+};
+
+int Counter::calls = 0;
+
+}
+
+TEST(GLConfig, SkipsRedundantCalls) {
+    Counter::calls = 0;
+    gl::Value<Counter> value;
+
+    value = 0;
+    EXPECT_EQ(0, Counter::calls);
+    EXPECT_EQ(1u, value.getRedundantCalls());
+
+    value = 1;
+    value = 1;
+    EXPECT_EQ(1, Counter::calls);
+    EXPECT_EQ(2u, value.getRedundantCalls());
+}
+
+TEST(GLConfig, ResetForcesCall) {
+    Counter::calls = 0;
+    gl::Value<Counter> value;
+
+    value = 1;
+    EXPECT_TRUE(value.isCurrent(1));
+
+    value.reset();
+    EXPECT_FALSE(value.isCurrent(1));
+
+    value = 1;
+    EXPECT_EQ(2, Counter::calls);
+    EXPECT_TRUE(value.isCurrent(1));
+}
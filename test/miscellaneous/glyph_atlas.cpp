@@ -0,0 +1,134 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/geometry/glyph_atlas.hpp>
+#include <mbgl/text/font_stack.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+namespace {
+
+// With the 3px buffer and padding, an 8x8 glyph takes up a 20x20 slot in the atlas.
+SDFGlyph glyph(uint32_t id, uint32_t width, uint32_t height) {
+    SDFGlyph result;
+    result.id = id;
+    result.bitmap = std::string((width + 6) * (height + 6), char(id));
+    result.metrics.width = width;
+    result.metrics.height = height;
+    result.metrics.advance = width;
+    return result;
+}
+
+}
+
+TEST(GlyphAtlas, ReleasesGlyphsOfRemovedTiles) {
+    GlyphAtlas atlas(64, 64);
+    FontStack stack;
+    stack.insert('a', glyph('a', 8, 8));
+    stack.insert('b', glyph('b', 8, 8));
+
+    GlyphPositions face;
+    atlas.addGlyphs(1, U"ab", "Test", stack, face);
+    atlas.addGlyphs(2, U"a", "Test", stack, face);
+    EXPECT_EQ(2u, atlas.getStats().glyphs);
+    EXPECT_EQ(800u, atlas.getStats().usedArea);
+    EXPECT_EQ(4096u, atlas.getStats().totalArea);
+
+    // "a" is still used by the second tile.
+    atlas.removeGlyphs(1);
+    EXPECT_EQ(1u, atlas.getStats().glyphs);
+    EXPECT_DOUBLE_EQ(400.0 / 4096, atlas.getStats().utilization());
+
+    atlas.removeGlyphs(2);
+    EXPECT_EQ(0u, atlas.getStats().glyphs);
+    EXPECT_EQ(0u, atlas.getStats().usedArea);
+}
+
+TEST(GlyphAtlas, CompactsFragmentedSpace) {
+    GlyphAtlas atlas(64, 64);
+    FontStack stack;
+    const std::u32string small = U"abcdefghi";
+    for (char32_t chr : small) {
+        stack.insert(chr, glyph(chr, 8, 8));
+    }
+    stack.insert('T', glyph('T', 8, 28));
+
+    // Every tile uses one of the nine slots that fill the atlas in a 3x3 grid. Free them in a
+    // checkerboard pattern, so that there's enough space for a tall glyph, but not in one piece.
+    std::vector<uintptr_t> kept;
+    for (size_t i = 0; i < small.size(); i++) {
+        GlyphPositions face;
+        atlas.addGlyphs(i + 1, small.substr(i, 1), "Test", stack, face);
+        const Rect<uint16_t> rect = face.at(small[i]).rect;
+        ASSERT_TRUE(rect.hasArea());
+
+        if ((rect.x / 20 + rect.y / 20) % 2) {
+            kept.push_back(i + 1);
+        }
+    }
+    ASSERT_EQ(4u, kept.size());
+
+    for (size_t i = 0; i < small.size(); i++) {
+        if (std::find(kept.begin(), kept.end(), i + 1) == kept.end()) {
+            atlas.removeGlyphs(i + 1);
+        }
+    }
+
+    EXPECT_EQ(0u, atlas.getGeneration());
+
+    GlyphPositions face;
+    atlas.addGlyphs(100, U"T", "Test", stack, face);
+    ASSERT_TRUE(face.at('T').rect.hasArea());
+    EXPECT_EQ(1u, atlas.getGeneration());
+    EXPECT_EQ(1u, atlas.getStats().compactions);
+    EXPECT_EQ(0u, atlas.getStats().failures);
+    EXPECT_EQ(5u, atlas.getStats().glyphs);
+
+    // Tiles whose glyphs moved have to be rebuilt; the tile that triggered the compaction
+    // only got its glyph afterwards.
+    const auto relocated = atlas.takeRelocatedTiles();
+    EXPECT_FALSE(relocated.empty());
+    EXPECT_EQ(0u, relocated.count(100));
+    for (uintptr_t tile : relocated) {
+        EXPECT_NE(kept.end(), std::find(kept.begin(), kept.end(), tile));
+    }
+    EXPECT_TRUE(atlas.takeRelocatedTiles().empty());
+
+    // Their old buckets keep using the old positions until they have been rebuilt.
+    const auto relocatedTile = *relocated.begin();
+    EXPECT_TRUE(atlas.isRelocated(relocatedTile, 0));
+    EXPECT_FALSE(atlas.isRelocated(relocatedTile, 1));
+    EXPECT_FALSE(atlas.isRelocated(100, 0));
+    atlas.finishRelocation(relocatedTile, 0);
+    EXPECT_TRUE(atlas.isRelocated(relocatedTile, 0));
+    atlas.finishRelocation(relocatedTile, 1);
+    EXPECT_FALSE(atlas.isRelocated(relocatedTile, 0));
+
+    // Glyphs keep their positions when they're added again.
+    GlyphPositions before;
+    atlas.addGlyphs(relocatedTile, small.substr(relocatedTile - 1, 1), "Test", stack, before);
+    GlyphPositions after;
+    atlas.addGlyphs(200, small.substr(relocatedTile - 1, 1), "Test", stack, after);
+    EXPECT_EQ(before.at(small[relocatedTile - 1]).rect, after.at(small[relocatedTile - 1]).rect);
+}
+
+TEST(GlyphAtlas, DoesNotCompactWhenGlyphsDontFit) {
+    GlyphAtlas atlas(64, 64);
+    FontStack stack;
+    stack.insert('a', glyph('a', 8, 8));
+    stack.insert('b', glyph('b', 8, 8));
+    stack.insert('T', glyph('T', 40, 40));
+
+    GlyphPositions face;
+    atlas.addGlyphs(1, U"a", "Test", stack, face);
+    atlas.addGlyphs(2, U"b", "Test", stack, face);
+    atlas.removeGlyphs(2);
+    atlas.addGlyphs(3, U"T", "Test", stack, face);
+
+    // The atlas is too small for both glyphs, no matter how they're packed.
+    EXPECT_FALSE(face.at('T').rect.hasArea());
+    EXPECT_EQ(0u, atlas.getStats().compactions);
+    EXPECT_EQ(1u, atlas.getStats().failures);
+    EXPECT_TRUE(atlas.takeRelocatedTiles().empty());
+}
@@ -0,0 +1,34 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/interned_string.hpp>
+
+#include <unordered_map>
+
+using namespace mbgl;
+
+TEST(InternedString, Equality) {
+    const InternedString water(std::string("water"));
+    const InternedString roads(std::string("roads"));
+
+    EXPECT_EQ(water, InternedString(std::string("water")));
+    EXPECT_NE(water, roads);
+    EXPECT_EQ("water", water.str());
+
+    // Equal strings share the stored copy.
+    EXPECT_EQ(&water.str(), &InternedString(std::string("water")).str());
+}
+
+TEST(InternedString, Empty) {
+    EXPECT_TRUE(InternedString().empty());
+    EXPECT_EQ(InternedString(), InternedString(std::string()));
+}
+
+TEST(InternedString, Hash) {
+    std::unordered_map<InternedString, int> map;
+    map[InternedString(std::string("water"))] = 1;
+    map[InternedString(std::string("roads"))] = 2;
+
+    EXPECT_EQ(1, map[InternedString(std::string("water"))]);
+    EXPECT_EQ(2, map[InternedString(std::string("roads"))]);
+    EXPECT_EQ(2u, map.size());
+}
@@ -0,0 +1,84 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/font_stack.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+ShapingKey key(const std::u32string& text, float maxWidth = 240) {
+    return { text, maxWidth, 24, 0.5, 0.5, 0.5, 0, 0, 0 };
+}
+
+Shaping shaping(const std::u32string& text) {
+    Shaping result(0, 0, text);
+    result.positionedGlyphs.emplace_back(text.front(), 0, 0);
+    return result;
+}
+
+}
+
+TEST(ShapingCache, HitsAndMisses) {
+    ShapingCache cache;
+    Shaping result;
+
+    EXPECT_FALSE(cache.get(key(U"Main Street"), result));
+    cache.put(key(U"Main Street"), shaping(U"Main Street"));
+
+    ASSERT_TRUE(cache.get(key(U"Main Street"), result));
+    EXPECT_EQ(U"Main Street", result.text);
+
+    // Any layout parameter is part of the key.
+    EXPECT_FALSE(cache.get(key(U"Main Street", 0), result));
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(1u, stats.size);
+    EXPECT_DOUBLE_EQ(1.0 / 3.0, stats.hitRate());
+}
+
+TEST(ShapingCache, EvictsLeastRecentlyUsed) {
+    ShapingCache cache(2);
+    Shaping result;
+
+    cache.put(key(U"a"), shaping(U"a"));
+    cache.put(key(U"b"), shaping(U"b"));
+
+    // Touch "a" so that "b" is evicted next.
+    EXPECT_TRUE(cache.get(key(U"a"), result));
+    cache.put(key(U"c"), shaping(U"c"));
+
+    EXPECT_TRUE(cache.get(key(U"a"), result));
+    EXPECT_FALSE(cache.get(key(U"b"), result));
+    EXPECT_TRUE(cache.get(key(U"c"), result));
+    EXPECT_EQ(2u, cache.getStats().size);
+}
+
+TEST(ShapingCache, FontStack) {
+    FontStack stack;
+
+    SDFGlyph glyph;
+    glyph.id = 'a';
+    glyph.metrics.width = 10;
+    glyph.metrics.height = 10;
+    glyph.metrics.advance = 12;
+    stack.insert('a', glyph);
+
+    const auto shape = [&] {
+        return stack.getShaping(U"aa", 0, 24, 0.5, 0.5, 0.5, 0, vec2<float>(0, 0));
+    };
+
+    const Shaping first = shape();
+    const Shaping second = shape();
+    ASSERT_EQ(2u, second.positionedGlyphs.size());
+    EXPECT_EQ(first.positionedGlyphs[1].x, second.positionedGlyphs[1].x);
+    EXPECT_EQ(first.right, second.right);
+    EXPECT_EQ(1u, stack.getShapingCacheStats().hits);
+
+    // Adding glyphs invalidates shapings that may have skipped them.
+    glyph.id = 'b';
+    stack.insert('b', glyph);
+    EXPECT_EQ(0u, stack.getShapingCacheStats().size);
+}
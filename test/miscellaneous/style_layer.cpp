@@ -0,0 +1,154 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/style/style_layer.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+std::unique_ptr<StyleLayer> lineLayer(const PropertyValue& width) {
+    std::map<ClassID, ClassProperties> styles;
+    styles[ClassID::Default].set(PropertyKey::LineWidth, width);
+
+    auto layer = std::make_unique<StyleLayer>("line", std::move(styles));
+    layer->type = StyleLayerType::Line;
+    return layer;
+}
+
+}
+
+TEST(StyleLayer, NeedsUpdateWhenCrossingStops) {
+    auto layer = lineLayer(Function<float>(StopsFunction<float>({ { 10, 1 }, { 12, 1 }, { 14, 5 } }, 1)));
+    const TimePoint now = Clock::now();
+    ZoomHistory zoomHistory;
+
+    layer->setClasses({}, now, PropertyTransition { Duration::zero(), Duration::zero() });
+    EXPECT_TRUE(layer->needsUpdate(10.5));
+
+    zoomHistory.update(10.5, now);
+    layer->updateProperties(10.5, now, zoomHistory);
+    EXPECT_EQ(1, layer->getProperties<LineProperties>().width);
+
+    // The width is the same between the first two stops, but the dash array scaling uses the
+    // integer zoom level.
+    EXPECT_FALSE(layer->needsUpdate(10.5));
+    EXPECT_FALSE(layer->needsUpdate(10.9));
+    EXPECT_TRUE(layer->needsUpdate(11.1));
+    EXPECT_TRUE(layer->needsUpdate(9.9));
+
+    // Between stops with different values, every zoom level evaluates differently.
+    zoomHistory.update(13, now);
+    layer->updateProperties(13, now, zoomHistory);
+    EXPECT_EQ(3, layer->getProperties<LineProperties>().width);
+    EXPECT_FALSE(layer->needsUpdate(13));
+    EXPECT_TRUE(layer->needsUpdate(13.1));
+
+    // Changing the classes invalidates the properties.
+    layer->setClasses({}, now, PropertyTransition { Duration::zero(), Duration::zero() });
+    EXPECT_TRUE(layer->needsUpdate(13));
+}
+
+TEST(StyleLayer, NeedsUpdateDuringTransitions) {
+    auto layer = lineLayer(Function<float>(ConstantFunction<float>(2)));
+    const TimePoint now = Clock::now();
+    ZoomHistory zoomHistory;
+    zoomHistory.update(10, now);
+
+    layer->setClasses({}, now, PropertyTransition { std::chrono::seconds(1), Duration::zero() });
+    layer->updateProperties(10, now, zoomHistory);
+    EXPECT_TRUE(layer->needsUpdate(10));
+
+    layer->updateProperties(10, now + std::chrono::seconds(2), zoomHistory);
+    EXPECT_EQ(2, layer->getProperties<LineProperties>().width);
+    EXPECT_FALSE(layer->needsUpdate(10));
+    EXPECT_FALSE(layer->needsUpdate(10.5));
+}
+
+TEST(StyleLayer, ClassTransitions) {
+    std::map<ClassID, ClassProperties> styles;
+    styles[ClassID::Default].set(PropertyKey::LineWidth, Function<float>(ConstantFunction<float>(2)));
+    styles[ClassDictionary::Get().lookup("wide")].set(PropertyKey::LineWidth, Function<float>(ConstantFunction<float>(6)));
+
+    StyleLayer layer("line", std::move(styles));
+    layer.type = StyleLayerType::Line;
+
+    const PropertyTransition transition { std::chrono::seconds(1), Duration::zero() };
+    const TimePoint now = Clock::now();
+    ZoomHistory zoomHistory;
+    zoomHistory.update(10, now);
+
+    layer.setClasses({}, now, transition);
+    layer.updateProperties(10, now + std::chrono::seconds(1), zoomHistory);
+    EXPECT_FALSE(layer.hasTransitions());
+    EXPECT_EQ(2, layer.getProperties<LineProperties>().width);
+
+    layer.setClasses({ "wide" }, now + std::chrono::seconds(1), transition);
+    EXPECT_TRUE(layer.hasTransitions());
+
+    layer.updateProperties(10, now + std::chrono::milliseconds(1500), zoomHistory);
+    EXPECT_TRUE(layer.hasTransitions());
+    EXPECT_FLOAT_EQ(4, layer.getProperties<LineProperties>().width);
+
+    layer.updateProperties(10, now + std::chrono::seconds(2), zoomHistory);
+    EXPECT_FALSE(layer.hasTransitions());
+    EXPECT_EQ(6, layer.getProperties<LineProperties>().width);
+}
+
+TEST(StyleLayer, InheritProperties) {
+    const PropertyTransition transition { std::chrono::seconds(1), Duration::zero() };
+    const TimePoint now = Clock::now();
+    ZoomHistory zoomHistory;
+    zoomHistory.update(10, now);
+
+    auto previous = lineLayer(Function<float>(ConstantFunction<float>(2)));
+    previous->setClasses({}, now, transition);
+    previous->updateProperties(10, now + std::chrono::seconds(1), zoomHistory);
+
+    // An unchanged property keeps its value without starting a new transition.
+    auto unchanged = lineLayer(Function<float>(ConstantFunction<float>(2)));
+    unchanged->inheritProperties(*previous);
+    unchanged->setClasses({}, now + std::chrono::seconds(1), transition);
+    EXPECT_FALSE(unchanged->hasTransitions());
+    unchanged->updateProperties(10, now + std::chrono::seconds(1), zoomHistory);
+    EXPECT_EQ(2, unchanged->getProperties<LineProperties>().width);
+
+    // A changed property transitions from the previous value.
+    auto changed = lineLayer(Function<float>(ConstantFunction<float>(4)));
+    changed->inheritProperties(*previous);
+    changed->setClasses({}, now + std::chrono::seconds(1), transition);
+    EXPECT_TRUE(changed->hasTransitions());
+    changed->updateProperties(10, now + std::chrono::milliseconds(1500), zoomHistory);
+    EXPECT_FLOAT_EQ(3, changed->getProperties<LineProperties>().width);
+    changed->updateProperties(10, now + std::chrono::seconds(2), zoomHistory);
+    EXPECT_EQ(4, changed->getProperties<LineProperties>().width);
+}
+
+TEST(StyleLayer, SetPaintProperties) {
+    const PropertyTransition transition { std::chrono::seconds(1), Duration::zero() };
+    const TimePoint now = Clock::now();
+    ZoomHistory zoomHistory;
+    zoomHistory.update(10, now);
+
+    auto layer = lineLayer(Function<float>(ConstantFunction<float>(2)));
+    layer->setClasses({}, now, transition);
+    layer->updateProperties(10, now + std::chrono::seconds(1), zoomHistory);
+
+    ClassProperties width;
+    width.set(PropertyKey::LineWidth, Function<float>(ConstantFunction<float>(4)));
+    layer->setPaintProperties(ClassID::Default, width);
+
+    // Values of classes that aren't applied don't transition.
+    ClassProperties wide;
+    wide.set(PropertyKey::LineWidth, Function<float>(ConstantFunction<float>(8)));
+    layer->setPaintProperties(ClassDictionary::Get().lookup("wide"), wide);
+
+    layer->setClasses({}, now + std::chrono::seconds(1), transition);
+    layer->updateProperties(10, now + std::chrono::milliseconds(1500), zoomHistory);
+    EXPECT_FLOAT_EQ(3, layer->getProperties<LineProperties>().width);
+    layer->updateProperties(10, now + std::chrono::seconds(2), zoomHistory);
+    EXPECT_EQ(4, layer->getProperties<LineProperties>().width);
+
+    layer->setClasses({ "wide" }, now + std::chrono::seconds(2), PropertyTransition { Duration::zero(), Duration::zero() });
+    layer->updateProperties(10, now + std::chrono::seconds(2), zoomHistory);
+    EXPECT_EQ(8, layer->getProperties<LineProperties>().width);
+}
@@ -1,6 +1,8 @@
 #include "../fixtures/util.hpp"
 
 #include <mbgl/style/style_parser.hpp>
+#include <mbgl/style/style_layer.hpp>
+#include <mbgl/style/class_dictionary.hpp>
 #include <mbgl/util/io.hpp>
 
 #include <mbgl/map/mode.hpp>
@@ -97,3 +99,121 @@ INSTANTIATE_TEST_CASE_P(StyleParser, StyleParserTest, ::testing::ValuesIn([] {
     EXPECT_GT(names.size(), 0ul);
     return names;
 }()));
+
+namespace {
+
+template <typename T>
+T evaluate(const ClassProperties& properties, PropertyKey key) {
+    const auto it = properties.properties.find(key);
+    if (it == properties.properties.end() || !it->second.is<Function<T>>()) {
+        ADD_FAILURE() << "property " << int(key) << " missing";
+        return T();
+    }
+    return evaluateFunction(it->second.get<Function<T>>(), 0);
+}
+
+}
+
+TEST(StyleParser, PaintClassesAndConstants) {
+    rapidjson::Document doc;
+    doc.Parse<0>(R"STYLE({
+        "version": 7,
+        "constants": {
+            "@water": "#0000ff",
+            "@opacity": 0.5,
+            "night": 0.25
+        },
+        "layers": [{
+            "id": "background",
+            "type": "background",
+            "paint": {
+                "background-color": "@water",
+                "background-opacity": "@opacity"
+            },
+            "paint.night": {
+                "background-opacity": 0.75
+            },
+            "painter": {
+                "background-opacity": 1
+            },
+            "paint.": {
+                "background-opacity": 1
+            }
+        }]
+    })STYLE");
+    ASSERT_FALSE(doc.HasParseError());
+
+    MapData data(MapMode::Continuous, 1.0f);
+    StyleParser parser(data);
+    parser.parse(doc);
+
+    // The parser adds the annotation layers after the ones of the style.
+    const auto layers = parser.getLayers();
+    ASSERT_FALSE(layers.empty());
+    ASSERT_EQ("background", layers[0]->id);
+    const auto& styles = layers[0]->styles;
+
+    // Only "paint" and "paint.<class>" are paint classes.
+    ASSERT_EQ(2u, styles.size());
+    const ClassProperties& paint = styles.at(ClassID::Default);
+    const Color color = evaluate<Color>(paint, PropertyKey::BackgroundColor);
+    EXPECT_EQ(0, color[0]);
+    EXPECT_EQ(0, color[1]);
+    EXPECT_EQ(1, color[2]);
+    EXPECT_EQ(0.5, evaluate<float>(paint, PropertyKey::BackgroundOpacity));
+
+    const ClassProperties& night = styles.at(ClassDictionary::Get().lookup("night"));
+    EXPECT_EQ(0.75, evaluate<float>(night, PropertyKey::BackgroundOpacity));
+}
+
+TEST(StyleParser, PropertyGroups) {
+    rapidjson::Document doc;
+    doc.Parse<0>(R"STYLE({
+        "constants": {
+            "@size": 12
+        },
+        "paint": {
+            "line-width": 2,
+            "text-size": "@size",
+            "text-opacity": "@missing",
+            "fill-opacity-transition": { "duration": 100 },
+            "unknown-opacity": 1
+        },
+        "layout": {
+            "line-cap": "round",
+            "text-field": "{name}@{ref}",
+            "visibility": "none"
+        }
+    })STYLE");
+    ASSERT_FALSE(doc.HasParseError());
+
+    FixtureLogObserver* observer = new FixtureLogObserver();
+    Log::setObserver(std::unique_ptr<Log::Observer>(observer));
+
+    MapData data(MapMode::Continuous, 1.0f);
+    StyleParser parser(data);
+    parser.parse(doc);
+
+    // Properties of every group that occurs are parsed, and only those.
+    ClassProperties paint;
+    parser.parsePaint(doc["paint"], paint);
+    EXPECT_EQ(2u, paint.properties.size());
+    EXPECT_EQ(2, evaluate<float>(paint, PropertyKey::LineWidth));
+    EXPECT_EQ(12, evaluate<float>(paint, PropertyKey::TextSize));
+    EXPECT_EQ(1u, paint.transitions.size());
+    EXPECT_EQ(1u, paint.transitions.count(PropertyKey::FillOpacity));
+
+    // Strings that start with '@' but aren't defined constants are left as they are.
+    EXPECT_EQ(0u, paint.properties.count(PropertyKey::TextOpacity));
+    EXPECT_EQ(1u, observer->count({ EventSeverity::Warning, Event::ParseStyle, -1,
+                                    "value of 'text-opacity' must be a number, or a number function" }));
+
+    util::ptr<StyleBucket> bucket = std::make_shared<StyleBucket>(StyleLayerType::Symbol);
+    parser.parseLayout(doc["layout"], bucket);
+    EXPECT_EQ(VisibilityType::None, bucket->visibility);
+    EXPECT_EQ(CapType::Round, evaluate<CapType>(bucket->layout, PropertyKey::LineCap));
+    EXPECT_EQ("{name}@{ref}", evaluate<std::string>(bucket->layout, PropertyKey::TextField));
+
+    EXPECT_TRUE(observer->unchecked().empty());
+    Log::removeObserver();
+}
@@ -17,6 +17,31 @@ TEST(Variant, toString) {
     EXPECT_EQ("false", toString( false ));
 }
 
+TEST(Variant, ShortStrings) {
+    // Short strings point into their own storage, which has to survive assignment and swapping.
+    Value a = std::string("short");
+    Value b = std::string("other");
+    Value c = int64_t(42);
+
+    a = b;
+    EXPECT_EQ("other", a.get<std::string>());
+    a = std::string("moved");
+    EXPECT_EQ("moved", a.get<std::string>());
+    c = std::move(a);
+    EXPECT_EQ("moved", c.get<std::string>());
+
+    swap(b, c);
+    EXPECT_EQ("moved", b.get<std::string>());
+    EXPECT_EQ("other", c.get<std::string>());
+    b.get<std::string>() += " and appended";
+    EXPECT_EQ("moved and appended", b.get<std::string>());
+
+    Value d = int64_t(7);
+    swap(c, d);
+    EXPECT_EQ(7, c.get<int64_t>());
+    EXPECT_EQ("other", d.get<std::string>());
+}
+
 TEST(Variant, RelaxedEquality) {
     // Compare to bool
     EXPECT_TRUE(util::relaxed_equal(bool(false), bool(false)));
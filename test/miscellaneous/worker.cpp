@@ -0,0 +1,42 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/worker.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(Worker, ParallelFor) {
+    Worker worker(4);
+
+    std::vector<std::atomic<int>> calls(1000);
+    for (auto& count : calls) {
+        count = 0;
+    }
+
+    worker.parallelFor(calls.size(), [&](std::size_t i) {
+        calls[i]++;
+    });
+
+    for (const auto& count : calls) {
+        EXPECT_EQ(1, count);
+    }
+}
+
+TEST(Worker, ParallelForOnCallingThread) {
+    Worker worker(4);
+    const auto tid = std::this_thread::get_id();
+
+    // A single index doesn't need any workers.
+    worker.parallelFor(1, [&](std::size_t) {
+        EXPECT_EQ(tid, std::this_thread::get_id());
+    });
+
+    bool called = false;
+    worker.parallelFor(0, [&](std::size_t) {
+        called = true;
+    });
+    EXPECT_FALSE(called);
+}
@@ -6,6 +6,7 @@
 #include <mbgl/text/glyph_store.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/worker.hpp>
 
 using namespace mbgl;
 
@@ -24,7 +25,7 @@ public:
     }
 
     void loadGlyphStore(const GlyphStoreParams& params) {
-        glyphStore_.reset(new GlyphStore());
+        glyphStore_.reset(new GlyphStore(worker));
 
         glyphStore_->setObserver(this);
         glyphStore_->setURL(params.url);
@@ -46,6 +47,7 @@ public:
     }
 
 private:
+    Worker worker { 1 };
     std::unique_ptr<GlyphStore> glyphStore_;
     GlyphStoreTestCallback callback_;
 };
@@ -111,8 +113,7 @@ TEST_F(GlyphStoreTest, LoadingSuccess) {
         ASSERT_FALSE(store->hasGlyphRanges("Test Stack",  {{512, 767}}));
 
         auto fontStack = store->getFontStack(params.stack);
-        ASSERT_FALSE(fontStack->getMetrics().empty());
-        ASSERT_FALSE(fontStack->getSDFs().empty());
+        ASSERT_FALSE(fontStack->empty());
 
         stopTest();
     };
@@ -138,8 +139,7 @@ TEST_F(GlyphStoreTest, LoadingFail) {
         ASSERT_TRUE(error != nullptr);
 
         auto fontStack = store->getFontStack(params.stack);
-        ASSERT_TRUE(fontStack->getMetrics().empty());
-        ASSERT_TRUE(fontStack->getSDFs().empty());
+        ASSERT_TRUE(fontStack->empty());
 
         for (const auto& range : params.ranges) {
             ASSERT_FALSE(store->hasGlyphRanges(params.stack, {range}));
@@ -173,8 +173,7 @@ TEST_F(GlyphStoreTest, LoadingCorrupted) {
         ASSERT_TRUE(error != nullptr);
 
         auto fontStack = store->getFontStack(params.stack);
-        ASSERT_TRUE(fontStack->getMetrics().empty());
-        ASSERT_TRUE(fontStack->getSDFs().empty());
+        ASSERT_TRUE(fontStack->empty());
 
         for (const auto& range : params.ranges) {
             ASSERT_FALSE(store->hasGlyphRanges(params.stack, {range}));
@@ -220,8 +219,7 @@ TEST_F(GlyphStoreTest, InvalidURL) {
         ASSERT_TRUE(error != nullptr);
 
         auto fontStack = store->getFontStack(params.stack);
-        ASSERT_TRUE(fontStack->getMetrics().empty());
-        ASSERT_TRUE(fontStack->getSDFs().empty());
+        ASSERT_TRUE(fontStack->empty());
 
         stopTest();
     };